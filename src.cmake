@@ -107,6 +107,8 @@ set(CGAMELIST
     ${GAMELOGIC_DIR}/cgame/cg_marks.cpp
     ${GAMELOGIC_DIR}/cgame/cg_minimap.cpp
     ${GAMELOGIC_DIR}/cgame/cg_parseutils.cpp
+    ${GAMELOGIC_DIR}/cgame/cg_particle_kernel.cpp
+    ${GAMELOGIC_DIR}/cgame/cg_particle_kernel.h
     ${GAMELOGIC_DIR}/cgame/cg_particles.cpp
     ${GAMELOGIC_DIR}/cgame/cg_players.cpp
     ${GAMELOGIC_DIR}/cgame/cg_playerstate.cpp
@@ -117,6 +119,7 @@ set(CGAMELIST
     ${GAMELOGIC_DIR}/cgame/cg_rocket_draw.cpp
     ${GAMELOGIC_DIR}/cgame/cg_rocket_events.cpp
     ${GAMELOGIC_DIR}/cgame/cg_rocket_progressbar.cpp
+    ${GAMELOGIC_DIR}/cgame/cg_scenebatch.cpp
     ${GAMELOGIC_DIR}/cgame/cg_segmented_skeleton.cpp
     ${GAMELOGIC_DIR}/cgame/cg_segmented_skeleton.h
     ${GAMELOGIC_DIR}/cgame/cg_servercmds.cpp
@@ -130,6 +133,7 @@ set(CGAMELIST
     ${GAMELOGIC_DIR}/cgame/cg_weapons.cpp
     ${GAMELOGIC_DIR}/cgame/translation.cpp
     ${GAMELOGIC_DIR}/cgame/Filter.h
+    ${GAMELOGIC_DIR}/cgame/ServerListModel.h
     ${GAMELOGIC_DIR}/cgame/CombatFeedback.cpp
 
     ${GAMELOGIC_DIR}/cgame/rocket/rocket.cpp
@@ -183,6 +187,11 @@ set(SGAMELIST
     ${GAMELOGIC_DIR}/sgame/BaseClustering.cpp
     ${GAMELOGIC_DIR}/sgame/Entities.cpp
     ${GAMELOGIC_DIR}/sgame/Entities.h
+    ${GAMELOGIC_DIR}/sgame/GameplayStats.cpp
+    ${GAMELOGIC_DIR}/sgame/Profiler.cpp
+    ${GAMELOGIC_DIR}/sgame/Profiler.h
+    ${GAMELOGIC_DIR}/sgame/Replay.cpp
+    ${GAMELOGIC_DIR}/sgame/Replay.h
     ${GAMELOGIC_DIR}/sgame/sg_active.cpp
     ${GAMELOGIC_DIR}/sgame/sg_admin.cpp
     ${GAMELOGIC_DIR}/sgame/sg_admin.h
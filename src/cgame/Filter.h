@@ -22,6 +22,7 @@ along with Unvanquished.  If not, see <http://www.gnu.org/licenses/>.
 ===========================================================================
 */
 
+#include <array>
 
 template <class T>
 class Filter
@@ -137,3 +138,178 @@ public:
 		return total * ( 1.0f / total_weight );
 	}
 };
+
+/**
+ * @brief A Filter keeping at most N samples in a ring buffer, so that it never
+ *        allocates.
+ *
+ * Samples have to be accumulated in time order, the expired ones are then the
+ * oldest and are dropped one by one from the back instead of searching all of
+ * them. When more than N samples are within the width, the oldest is dropped.
+ * The weights of the Gaussian moving average are read from a table built by
+ * SetWidth when the width is smaller than N.
+ */
+template <class T, size_t N>
+class RingFilter
+{
+	std::array<std::pair<int,T>, N> samples;
+	size_t newest = 0;
+	size_t count = 0;
+	int width = 0;
+
+	std::array<float, N> kernel;
+	int kernelWidth = -1;
+
+	/**
+	 * @brief The Gaussian function used to calculate a Gaussian moving average.
+	 */
+	float Gaussian( float x )
+	{
+		return exp( -8.0f * x * x );
+	}
+
+	/**
+	 * @brief The weight of a sample taken dt units of time ago.
+	 */
+	float GaussianWeight( int dt )
+	{
+		if ( dt >= 0 && dt <= kernelWidth )
+		{
+			return kernel[ dt ];
+		}
+
+		return Gaussian( (float)dt / width );
+	}
+
+	/**
+	 * @brief Return the sample accumulated i samples before the most recent.
+	 */
+	std::pair<int,T>& Sample( size_t i )
+	{
+		return samples[ ( newest + N - i ) % N ];
+	}
+
+public:
+	/**
+	 * @brief Set the filter's width (in units of time).
+	 */
+	void SetWidth( int a_width )
+	{
+		if ( a_width == width && kernelWidth == width )
+		{
+			return;
+		}
+
+		width = a_width;
+		kernelWidth = -1;
+
+		if ( width > 0 && (size_t)width < N )
+		{
+			for ( int dt = 0; dt <= width; dt++ )
+			{
+				kernel[ dt ] = Gaussian( (float)dt / width );
+			}
+
+			kernelWidth = width;
+		}
+	}
+
+	/**
+	 * @brief Add a sample to the filter.
+	 */
+	void Accumulate( int time, const T& sample )
+	{
+		while ( count > 0 && time - Sample( count - 1 ).first > width )
+		{
+			count--;
+		}
+
+		if ( count == N )
+		{
+			count--;
+		}
+
+		newest = ( newest + 1 ) % N;
+		samples[ newest ] = std::make_pair( time, sample );
+		count++;
+	}
+
+	/**
+	 * @brief Delete all stored samples.
+	 */
+	void Reset( )
+	{
+		count = 0;
+	}
+
+	/**
+	 * @brief Check if there are any stored samples.
+	 */
+	bool IsEmpty( )
+	{
+		return count == 0;
+	}
+
+	/**
+	 * @brief Return the most recent sample.
+	 */
+	std::pair<int,T>& Last( )
+	{
+		return Sample( 0 );
+	}
+
+	/**
+	 * @brief Calculate the moving average of the stored samples.
+	 */
+	T MA( )
+	{
+		T total{};
+
+		for ( size_t i = 0; i < count; i++ )
+			total += Sample( i ).second;
+
+		return total * ( 1.0f / count );
+	}
+
+	/**
+	 * @brief Calculate the cubic moving average of the stored samples.
+	 */
+	T CubicMA( int time )
+	{
+		T total{};
+		float total_weight = 0;
+
+		for ( size_t i = 0; i < count; i++ )
+		{
+			std::pair<int,T> &s = Sample( i );
+			float weight;
+
+			weight = pow( 1.0f - (float)( time - s.first ) / width, 3 );
+			total_weight += weight;
+			total += s.second * weight;
+		}
+
+		return total * ( 1.0f / total_weight );
+	}
+
+	/**
+	 * @brief Calculate the Gaussian moving average of the stored samples.
+	 */
+	T GaussianMA( int time )
+	{
+		T total{};
+		float total_weight = 0;
+
+		for ( size_t i = 0; i < count; i++ )
+		{
+			std::pair<int,T> &s = Sample( i );
+			float weight;
+
+			weight = GaussianWeight( time - s.first );
+			total_weight += weight;
+			total += s.second * weight;
+		}
+
+		return total * ( 1.0f / total_weight );
+	}
+};
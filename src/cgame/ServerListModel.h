@@ -0,0 +1,208 @@
+/*
+===========================================================================
+
+Unvanquished GPL Source Code
+Copyright (C) 2023 Unvanquished Developers
+
+This file is part of the Unvanquished GPL Source Code (Unvanquished Source Code).
+
+Unvanquished is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Unvanquished is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Unvanquished.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+
+#ifndef SERVER_LIST_MODEL_H
+#define SERVER_LIST_MODEL_H
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+/**
+ * @brief A sorted and filtered view of a growing list of items, which are
+ *        referred to by their index.
+ *
+ * The items are kept sorted by every sort key as they are added, so that
+ * adding an item is a binary search and switching the sort key doesn't sort.
+ * Changes of the view are reported row by row, so that a UI only has to
+ * update the rows that changed. It doesn't know about servers or the UI.
+ */
+class ServerListModel
+{
+public:
+	using compare_type = std::function<bool( int, int )>;
+	using filter_type  = std::function<bool( int )>;
+
+	/** Called when an item is shown at a row. */
+	std::function<void( int row, int item )> onInsert;
+
+	/** Called when the item at a row is no longer shown. */
+	std::function<void( int row )> onRemove;
+
+	/** Called when the order of the view changed entirely. */
+	std::function<void()> onReset;
+
+	/**
+	 * @param compare_ A strict weak ordering of items for every sort key.
+	 */
+	explicit ServerListModel( std::vector<compare_type> compare_ ) :
+		compare( std::move( compare_ ) ),
+		sorted( compare.size() ),
+		filter( nullptr ),
+		sortKey( 0 )
+	{}
+
+	/**
+	 * @brief Removes all items, the owner of the view has to clear it itself.
+	 */
+	void Clear()
+	{
+		for ( std::vector<int> &items : sorted )
+		{
+			items.clear();
+		}
+
+		view.clear();
+		visible.clear();
+	}
+
+	/**
+	 * @brief Adds an item, and shows it if it passes the filter.
+	 */
+	void Add( int item )
+	{
+		for ( size_t key = 0; key < compare.size(); key++ )
+		{
+			std::vector<int> &items = sorted[ key ];
+			items.insert( std::upper_bound( items.begin(), items.end(), item, compare[ key ] ), item );
+		}
+
+		if ( item >= static_cast<int>( visible.size() ) )
+		{
+			visible.resize( item + 1, false );
+		}
+
+		if ( !Passes( item ) )
+		{
+			return;
+		}
+
+		auto position = std::upper_bound( view.begin(), view.end(), item, compare[ sortKey ] );
+		int row = position - view.begin();
+
+		view.insert( position, item );
+		visible[ item ] = true;
+
+		if ( onInsert ) onInsert( row, item );
+	}
+
+	/**
+	 * @brief Shows the items in the order of another sort key.
+	 */
+	void SetSortKey( size_t key )
+	{
+		if ( key == sortKey || key >= compare.size() )
+		{
+			return;
+		}
+
+		sortKey = key;
+		view.clear();
+
+		for ( int item : sorted[ sortKey ] )
+		{
+			if ( visible[ item ] )
+			{
+				view.push_back( item );
+			}
+		}
+
+		if ( onReset ) onReset();
+	}
+
+	/**
+	 * @brief Changes the filter, only the items whose visibility changed are
+	 *        inserted or removed.
+	 */
+	void SetFilter( filter_type filter_ )
+	{
+		filter = std::move( filter_ );
+
+		int row = 0;
+
+		for ( int item : sorted[ sortKey ] )
+		{
+			bool wasVisible = visible[ item ];
+			bool isVisible = Passes( item );
+
+			if ( wasVisible && !isVisible )
+			{
+				view.erase( view.begin() + row );
+				visible[ item ] = false;
+
+				if ( onRemove ) onRemove( row );
+			}
+			else if ( !wasVisible && isVisible )
+			{
+				view.insert( view.begin() + row, item );
+				visible[ item ] = true;
+
+				if ( onInsert ) onInsert( row, item );
+
+				row++;
+			}
+			else if ( isVisible )
+			{
+				row++;
+			}
+		}
+	}
+
+	int NumRows() const
+	{
+		return view.size();
+	}
+
+	/**
+	 * @return The item shown at a row, or -1.
+	 */
+	int Item( int row ) const
+	{
+		return row >= 0 && row < NumRows() ? view[ row ] : -1;
+	}
+
+private:
+	bool Passes( int item ) const
+	{
+		return filter == nullptr || filter( item );
+	}
+
+	/** The orderings of items for every sort key. */
+	std::vector<compare_type> compare;
+
+	/** All items, sorted by every sort key. */
+	std::vector<std::vector<int>> sorted;
+
+	/** The items shown, in the order of the current sort key. */
+	std::vector<int> view;
+
+	/** Whether an item is in the view. */
+	std::vector<bool> visible;
+
+	filter_type filter;
+
+	size_t sortKey;
+};
+
+#endif // SERVER_LIST_MODEL_H
@@ -177,6 +177,219 @@ void CG_BlendLerpFrame( lerpFrame_t *lf )
 	}
 }
 
+/*
+===================================================================
+
+Skeleton cache
+
+Every trap_R_BuildSkeleton call is a round trip to the engine, yet most
+models on screen cycle through the same few animation frames. The pose
+of every frame is built by the engine once, kept here and interpolated
+in the cgame, so idle players and buildables only cost engine calls for
+frames that aren't cached yet. Skeletons are blended in the cgame too.
+
+===================================================================
+*/
+
+static Log::Logger skeletonLogger("cgame.skeletoncache");
+
+static Cvar::Range<Cvar::Cvar<int>> cg_skeletonCacheSize(
+	"cg_skeletonCacheSize", "number of animation frames kept in the skeleton cache, 0 to disable it",
+	Cvar::NONE, 1024, 0, 65536 );
+
+struct cachedPose_t
+{
+	int                    lastUsed; // cg.clientFrame
+	refSkeletonType_t      type;
+	vec3_t                 bounds[ 2 ];
+	float                  scale;
+	std::vector<refBone_t> bones;
+};
+
+static std::unordered_map<uint64_t, cachedPose_t> poseCache;
+static int poseCacheFrame = -1;
+static int numPoseCacheHits;
+static int numPoseCacheMisses;
+
+/*
+===============
+CG_EvictPoses
+
+Drop the frames that haven't been used this frame, the cache size is
+exceeded only if all of them are in use
+===============
+*/
+static void CG_EvictPoses()
+{
+	for ( auto it = poseCache.begin(); it != poseCache.end(); )
+	{
+		if ( it->second.lastUsed != cg.clientFrame )
+		{
+			it = poseCache.erase( it );
+		}
+		else
+		{
+			++it;
+		}
+	}
+}
+
+/*
+===============
+CG_CachedPose
+
+Returns the pose of a single animation frame, nullptr if it can't be built
+===============
+*/
+static const cachedPose_t *CG_CachedPose( qhandle_t animation, int frame, bool clearOrigin )
+{
+	// refSkeleton_t is too large for the stack
+	static refSkeleton_t skel;
+
+	if ( poseCacheFrame != cg.clientFrame )
+	{
+		skeletonLogger.Debug( "%d hits, %d misses, %d frames cached",
+		                      numPoseCacheHits, numPoseCacheMisses, static_cast<int>( poseCache.size() ) );
+
+		poseCacheFrame = cg.clientFrame;
+		numPoseCacheHits = numPoseCacheMisses = 0;
+	}
+
+	uint64_t key = ( uint64_t( uint32_t( animation ) ) << 32 ) |
+	               ( uint64_t( uint32_t( frame ) & 0x7FFFFFFF ) << 1 ) |
+	               ( clearOrigin ? 1 : 0 );
+
+	auto it = poseCache.find( key );
+
+	if ( it != poseCache.end() )
+	{
+		numPoseCacheHits++;
+		it->second.lastUsed = cg.clientFrame;
+		return &it->second;
+	}
+
+	numPoseCacheMisses++;
+
+	if ( !trap_R_BuildSkeleton( &skel, animation, frame, frame, 0.0f, clearOrigin ) )
+	{
+		return nullptr;
+	}
+
+	if ( poseCache.size() >= static_cast<size_t>( cg_skeletonCacheSize.Get() ) )
+	{
+		CG_EvictPoses();
+	}
+
+	cachedPose_t &pose = poseCache[ key ];
+	pose.lastUsed = cg.clientFrame;
+	pose.type = skel.type;
+	VectorCopy( skel.bounds[ 0 ], pose.bounds[ 0 ] );
+	VectorCopy( skel.bounds[ 1 ], pose.bounds[ 1 ] );
+	pose.scale = skel.scale;
+	pose.bones.assign( skel.bones, skel.bones + skel.numBones );
+
+	return &pose;
+}
+
+/*
+===============
+CG_BuildSkeleton
+
+Same as trap_R_BuildSkeleton, but only asks the engine for frames that
+aren't in the skeleton cache
+===============
+*/
+bool CG_BuildSkeleton( refSkeleton_t *skel, qhandle_t animation, int startFrame, int endFrame, float frac, bool clearOrigin )
+{
+	if ( cg_skeletonCacheSize.Get() <= 0 )
+	{
+		return trap_R_BuildSkeleton( skel, animation, startFrame, endFrame, frac, clearOrigin );
+	}
+
+	const cachedPose_t *from = CG_CachedPose( animation, startFrame, clearOrigin );
+	const cachedPose_t *to = endFrame == startFrame ? from : CG_CachedPose( animation, endFrame, clearOrigin );
+
+	if ( !from || !to || from->bones.size() != to->bones.size() )
+	{
+		return trap_R_BuildSkeleton( skel, animation, startFrame, endFrame, frac, clearOrigin );
+	}
+
+	skel->type = to->type;
+	skel->scale = to->scale;
+	skel->numBones = to->bones.size();
+	std::copy( to->bones.begin(), to->bones.end(), skel->bones );
+
+	if ( from == to || frac >= 1.0f )
+	{
+		VectorCopy( to->bounds[ 0 ], skel->bounds[ 0 ] );
+		VectorCopy( to->bounds[ 1 ], skel->bounds[ 1 ] );
+		return true;
+	}
+
+	if ( frac <= 0.0f )
+	{
+		std::copy( from->bones.begin(), from->bones.end(), skel->bones );
+		VectorCopy( from->bounds[ 0 ], skel->bounds[ 0 ] );
+		VectorCopy( from->bounds[ 1 ], skel->bounds[ 1 ] );
+		return true;
+	}
+
+	for ( int i = 0; i < skel->numBones; i++ )
+	{
+		transform_t *t = &skel->bones[ i ].t;
+
+		TransStartLerp( t );
+		TransAddWeight( 1.0f - frac, &from->bones[ i ].t, t );
+		TransAddWeight( frac, &to->bones[ i ].t, t );
+		TransEndLerp( t );
+	}
+
+	for ( int i = 0; i < 3; i++ )
+	{
+		skel->bounds[ 0 ][ i ] = std::min( from->bounds[ 0 ][ i ], to->bounds[ 0 ][ i ] );
+		skel->bounds[ 1 ][ i ] = std::max( from->bounds[ 1 ][ i ], to->bounds[ 1 ][ i ] );
+	}
+
+	return true;
+}
+
+/*
+===============
+CG_BlendSkeleton
+
+Same as trap_R_BlendSkeleton, without the round trip to the engine
+===============
+*/
+bool CG_BlendSkeleton( refSkeleton_t *skel, const refSkeleton_t *blend, float frac )
+{
+	if ( skel->numBones != blend->numBones )
+	{
+		Log::Warn( "CG_BlendSkeleton: different number of bones %d != %d", skel->numBones, blend->numBones );
+		return false;
+	}
+
+	for ( int i = 0; i < skel->numBones; i++ )
+	{
+		transform_t t;
+
+		TransStartLerp( &t );
+		TransAddWeight( 1.0f - frac, &skel->bones[ i ].t, &t );
+		TransAddWeight( frac, &blend->bones[ i ].t, &t );
+		TransEndLerp( &t );
+
+		skel->bones[ i ].t = t;
+	}
+
+	// the blended pose fits in the union of both bounds
+	for ( int i = 0; i < 3; i++ )
+	{
+		skel->bounds[ 0 ][ i ] = std::min( skel->bounds[ 0 ][ i ], blend->bounds[ 0 ][ i ] );
+		skel->bounds[ 1 ][ i ] = std::max( skel->bounds[ 1 ][ i ], blend->bounds[ 1 ][ i ] );
+	}
+
+	return true;
+}
+
 /*
 ===============
 CG_BuildAnimSkeleton
@@ -202,7 +415,7 @@ void CG_BuildAnimSkeleton( const lerpFrame_t *lf, refSkeleton_t *newSkeleton, co
 		return;
 	}
 
-	if ( !trap_R_BuildSkeleton( newSkeleton, lf->animation->handle, lf->oldFrame, lf->frame, 1 - lf->backlerp, lf->animation->clearOrigin ) )
+	if ( !CG_BuildSkeleton( newSkeleton, lf->animation->handle, lf->oldFrame, lf->frame, 1 - lf->backlerp, lf->animation->clearOrigin ) )
 	{
 		Log::Warn( "CG_BuildAnimSkeleton: Can't build skeleton" );
 	}
@@ -212,7 +425,7 @@ void CG_BuildAnimSkeleton( const lerpFrame_t *lf, refSkeleton_t *newSkeleton, co
 	{
 		if ( newSkeleton->type != refSkeletonType_t::SK_INVALID && oldSkeleton->type != refSkeletonType_t::SK_INVALID && newSkeleton->numBones == oldSkeleton->numBones )
 		{
-			if ( !trap_R_BlendSkeleton( newSkeleton, oldSkeleton, lf->blendlerp ) )
+			if ( !CG_BlendSkeleton( newSkeleton, oldSkeleton, lf->blendlerp ) )
 			{
 				Log::Warn( "CG_BuildAnimSkeleton: Can't blend skeletons" );
 				return;
@@ -27,6 +27,173 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include "cg_local.h"
 
+/*
+===================================================================
+
+Several particle and trail systems are often attached to the same
+entity or tag and every one of them asks for its transform a few times
+per frame. Tag and centity transforms are therefore resolved once per
+frame per target and shared by all attachments to that target.
+A centity's transform is resolved again once the centity is lerped,
+so attachments queried earlier in the frame pick up its new position.
+Particle attachments are read directly, as particles move within the
+frame.
+
+===================================================================
+*/
+
+struct attachmentTransform_t
+{
+	int    frame; // cg.clientFrame this was resolved in
+	int    version; // changes whenever it is resolved again
+	vec3_t origin;
+	vec3_t axis[ 3 ];
+};
+
+struct tagTransform_t
+{
+	refEntity_t           parent;
+	qhandle_t             model;
+	char                  tagName[ MAX_QPATH ];
+	attachmentTransform_t transform;
+};
+
+static attachmentTransform_t       centTransforms[ MAX_GENTITIES ];
+
+// entries beyond numTagTransforms are unused, but keep their storage
+static std::vector<tagTransform_t> tagTransforms;
+static size_t                      numTagTransforms = 0;
+static int                         tagTransformsFrame = -1;
+static int                         transformVersion = 0;
+
+/*
+===============
+CG_CentTransform
+===============
+*/
+static const attachmentTransform_t *CG_CentTransform( int centNum )
+{
+	attachmentTransform_t *t = &centTransforms[ centNum ];
+
+	if ( t->frame == cg.clientFrame )
+	{
+		return t;
+	}
+
+	t->frame = cg.clientFrame;
+	t->version = ++transformVersion;
+
+	if ( centNum == cg.predictedPlayerState.clientNum )
+	{
+		// this is smoother if it's the local client
+		VectorCopy( cg.predictedPlayerState.origin, t->origin );
+	}
+	else
+	{
+		VectorCopy( cg_entities[ centNum ].lerpOrigin, t->origin );
+	}
+
+	AnglesToAxis( cg_entities[ centNum ].lerpAngles, t->axis );
+
+	return t;
+}
+
+/*
+===============
+CG_TagTransform
+===============
+*/
+static const attachmentTransform_t *CG_TagTransform( attachment_t *a )
+{
+	tagTransform_t *tag;
+	refEntity_t    re{};
+
+	if ( tagTransformsFrame != cg.clientFrame )
+	{
+		tagTransformsFrame = cg.clientFrame;
+		numTagTransforms = 0;
+	}
+
+	// the cheap fields first, the whole parent only if they match
+	for ( size_t i = 0; i < numTagTransforms; i++ )
+	{
+		tag = &tagTransforms[ i ];
+
+		if ( tag->model == a->model &&
+		     tag->parent.hModel == a->parent.hModel &&
+		     VectorCompare( tag->parent.origin, a->parent.origin ) &&
+		     !Q_stricmp( tag->tagName, a->tagName ) &&
+		     !memcmp( &tag->parent, &a->parent, sizeof( refEntity_t ) ) )
+		{
+			return &tag->transform;
+		}
+	}
+
+	AxisCopy( axisDefault, re.axis );
+	CG_PositionRotatedEntityOnTag( &re, &a->parent, a->model, a->tagName );
+
+	// don't bother sharing tags with unusually long names
+	if ( strlen( a->tagName ) >= sizeof( tag->tagName ) )
+	{
+		static attachmentTransform_t uncached;
+
+		VectorCopy( re.origin, uncached.origin );
+		AxisCopy( re.axis, uncached.axis );
+		return &uncached;
+	}
+
+	if ( numTagTransforms == tagTransforms.size() )
+	{
+		tagTransforms.emplace_back();
+	}
+
+	tag = &tagTransforms[ numTagTransforms++ ];
+	tag->parent = a->parent;
+	tag->model = a->model;
+	Q_strncpyz( tag->tagName, a->tagName, sizeof( tag->tagName ) );
+	tag->transform.frame = cg.clientFrame;
+	VectorCopy( re.origin, tag->transform.origin );
+	AxisCopy( re.axis, tag->transform.axis );
+
+	return &tag->transform;
+}
+
+/*
+===============
+CG_ResolveAttachment
+
+Fetch the transform of a tag or centity attachment for this frame
+===============
+*/
+static void CG_ResolveAttachment( attachment_t *a )
+{
+	const attachmentTransform_t *t;
+
+	if ( a->type == AT_TAG )
+	{
+		if ( a->resolvedFrame == cg.clientFrame )
+		{
+			return;
+		}
+
+		t = CG_TagTransform( a );
+	}
+	else
+	{
+		t = CG_CentTransform( a->centNum );
+
+		if ( a->resolvedFrame == cg.clientFrame && a->resolvedVersion == t->version )
+		{
+			return;
+		}
+	}
+
+	a->resolvedFrame = cg.clientFrame;
+	a->resolvedVersion = t->version;
+	VectorCopy( t->origin, a->resolvedOrigin );
+	AxisCopy( t->axis, a->resolvedAxis );
+}
+
 /*
 ===============
 CG_AttachmentPoint
@@ -36,8 +203,6 @@ Return the attachment point
 */
 bool CG_AttachmentPoint( attachment_t *a, vec3_t v )
 {
-	centity_t *cent;
-
 	if ( !a )
 	{
 		return false;
@@ -63,10 +228,8 @@ bool CG_AttachmentPoint( attachment_t *a, vec3_t v )
 				return false;
 			}
 
-			AxisCopy( axisDefault, a->re.axis );
-			CG_PositionRotatedEntityOnTag( &a->re, &a->parent,
-			                               a->model, a->tagName );
-			VectorCopy( a->re.origin, v );
+			CG_ResolveAttachment( a );
+			VectorCopy( a->resolvedOrigin, v );
 			break;
 
 		case AT_CENT:
@@ -75,17 +238,8 @@ bool CG_AttachmentPoint( attachment_t *a, vec3_t v )
 				return false;
 			}
 
-			if ( a->centNum == cg.predictedPlayerState.clientNum )
-			{
-				// this is smoother if it's the local client
-				VectorCopy( cg.predictedPlayerState.origin, v );
-			}
-			else
-			{
-				cent = &cg_entities[ a->centNum ];
-				VectorCopy( cent->lerpOrigin, v );
-			}
-
+			CG_ResolveAttachment( a );
+			VectorCopy( a->resolvedOrigin, v );
 			break;
 
 		case AT_PARTICLE:
@@ -130,9 +284,6 @@ Return the attachment direction
 */
 bool CG_AttachmentDir( attachment_t *a, vec3_t v )
 {
-	vec3_t    forward;
-	centity_t *cent;
-
 	if ( !a )
 	{
 		return false;
@@ -149,7 +300,8 @@ bool CG_AttachmentDir( attachment_t *a, vec3_t v )
 				return false;
 			}
 
-			VectorCopy( a->re.axis[ 0 ], v );
+			CG_ResolveAttachment( a );
+			VectorCopy( a->resolvedAxis[ 0 ], v );
 			break;
 
 		case AT_CENT:
@@ -158,9 +310,8 @@ bool CG_AttachmentDir( attachment_t *a, vec3_t v )
 				return false;
 			}
 
-			cent = &cg_entities[ a->centNum ];
-			AngleVectors( cent->lerpAngles, forward, nullptr, nullptr );
-			VectorCopy( forward, v );
+			CG_ResolveAttachment( a );
+			VectorCopy( a->resolvedAxis[ 0 ], v );
 			break;
 
 		case AT_PARTICLE:
@@ -199,8 +350,6 @@ Return the attachment axis
 */
 bool CG_AttachmentAxis( attachment_t *a, vec3_t axis[ 3 ] )
 {
-	centity_t *cent;
-
 	if ( !a )
 	{
 		return false;
@@ -217,7 +366,8 @@ bool CG_AttachmentAxis( attachment_t *a, vec3_t axis[ 3 ] )
 				return false;
 			}
 
-			AxisCopy( a->re.axis, axis );
+			CG_ResolveAttachment( a );
+			AxisCopy( a->resolvedAxis, axis );
 			break;
 
 		case AT_CENT:
@@ -226,8 +376,8 @@ bool CG_AttachmentAxis( attachment_t *a, vec3_t axis[ 3 ] )
 				return false;
 			}
 
-			cent = &cg_entities[ a->centNum ];
-			AnglesToAxis( cent->lerpAngles, axis );
+			CG_ResolveAttachment( a );
+			AxisCopy( a->resolvedAxis, axis );
 			break;
 
 		case AT_PARTICLE:
@@ -339,6 +489,7 @@ void CG_AttachToCent( attachment_t *a )
 
 	a->type = AT_CENT;
 	a->attached = true;
+	a->resolvedFrame = -1;
 }
 
 /*
@@ -357,6 +508,7 @@ void CG_AttachToTag( attachment_t *a )
 
 	a->type = AT_TAG;
 	a->attached = true;
+	a->resolvedFrame = -1;
 }
 
 /*
@@ -407,6 +559,7 @@ void CG_SetAttachmentCent( attachment_t *a, centity_t *cent )
 
 	a->centNum = cent->currentState.number;
 	a->centValid = true;
+	a->resolvedFrame = -1;
 }
 
 /*
@@ -426,6 +579,7 @@ void CG_SetAttachmentTag( attachment_t *a, refEntity_t *parent,
 	a->model = model;
 	Q_strncpyz( a->tagName, tagName, MAX_STRING_CHARS );
 	a->tagValid = true;
+	a->resolvedFrame = -1;
 }
 
 /*
@@ -459,3 +613,15 @@ void CG_SetAttachmentOffset( attachment_t *a, vec3_t v )
 	VectorCopy( v, a->offset );
 	a->hasOffset = true;
 }
+
+/*
+===============
+CG_InvalidateCentTransform
+
+The centity moved, resolve its transform again when it is next asked for
+===============
+*/
+void CG_InvalidateCentTransform( int centNum )
+{
+	centTransforms[ centNum ].frame = -1;
+}
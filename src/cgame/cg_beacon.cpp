@@ -153,23 +153,19 @@ else if( !Q_stricmp( token.string, #x ) ) \
  */
 static bool LoadExplicitBeacons()
 {
-	unsigned i;
-	centity_t     *ent;
 	entityState_t *es;
 	cbeacon_t     *beacon;
 
 	cg.highlightedBeacon = nullptr;
 
 	// Find beacons and add them to cg.beacons.
-	for( cg.beaconCount = 0, i = 0; i < cg.snap->entities.size(); i++ )
+	cg.beaconCount = 0;
+
+	for ( centity_t *ent : CG_EntitiesOfType( entityType_t::ET_BEACON ) )
 	{
-		ent    = cg_entities + cg.snap->entities[ i ].number;
 		es     = &ent->currentState;
 		beacon = &ent->beacon;
 
-		if ( es->eType != entityType_t::ET_BEACON )
-			continue;
-
 		if( es->modelindex <= BCT_NONE || es->modelindex >= NUM_BEACON_TYPES )
 			continue;
 
@@ -226,22 +222,14 @@ static bool LoadImplicitBeacons()
 	     cg.predictedPlayerState.persistant[ PERS_SPECSTATE ] == SPECTATOR_NOT &&
 	     cg.predictedPlayerState.stats[ STAT_HEALTH ] > 0 )
 	{
-		for ( int clientNum = 0; clientNum < MAX_CLIENTS; clientNum++ )
+		// Can only track valid targets, which are the players in the snapshot.
+		// TODO: Make beacons expire properly anyway.
+		// Only tag enemies like this, teammates have an explicit beacon.
+		for ( centity_t *ent : CG_PlayersOfTeam( TEAM_HUMANS ) )
 		{
-			centity_t     *ent;
-			entityState_t *es;
-			clientInfo_t  *client;
-
-			// Can only track valid targets.
-			// TODO: Make beacons expire properly anyway.
-			if ( !( ent = &cg_entities[ clientNum ] )->valid )            continue;
-
-			// Only tag enemies like this, teammates have an explicit beacon.
-			if ( !( client = &cgs.clientinfo[ clientNum ] )->infoValid ) continue;
-			if ( client->team != TEAM_HUMANS )                           continue;
+			entityState_t *es = &ent->currentState;
 
-			//ent = &cg_entities[ clientNum ];
-			es = &ent->currentState;
+			if ( !cgs.clientinfo[ es->clientNum ].infoValid ) continue;
 
 			cbeacon_t *beacon = &ent->beacon;
 
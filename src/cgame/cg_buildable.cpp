@@ -562,11 +562,39 @@ static bool CG_RegisterBuildableAnimation( buildableInfo_t *ci, const char *mode
 	return true;
 }
 
+/*
+===============
+CG_ParseBuildableConfigs
+
+Parses the buildable configs that don't depend on which models get
+registered, before CG_InitBuildables registers anything
+===============
+*/
+void CG_ParseBuildableConfigs()
+{
+	char        filename[ MAX_QPATH ];
+	buildable_t buildable;
+
+	memset( cg_buildables, 0, sizeof( cg_buildables ) );
+
+	for ( buildable = (buildable_t)( BA_NONE + 1 ); buildable < BA_NUM_BUILDABLES;
+	      buildable = (buildable_t)( buildable + 1 ) )
+	{
+		//sound.cfg
+		Com_sprintf( filename, sizeof( filename ), "sound/buildables/%s/sound.cfg", BG_Buildable( buildable )->name );
+
+		if ( !CG_ParseBuildableSoundFile( filename, buildable ) )
+		{
+			Log::Warn( "failed to load sound file %s", filename );
+		}
+	}
+}
+
 /*
 ===============
 CG_InitBuildables
 
-Initialises the animation db
+Initialises the animation db, after CG_ParseBuildableConfigs
 ===============
 */
 void CG_InitBuildables()
@@ -580,8 +608,6 @@ void CG_InitBuildables()
 	int          j;
 	buildableAnimNumber_t anim;
 
-	memset( cg_buildables, 0, sizeof( cg_buildables ) );
-
 	//default sounds
 	for ( j = BANIM_NONE + 1; j < MAX_BUILDABLE_ANIMATIONS; j++ )
 	{
@@ -665,14 +691,6 @@ void CG_InitBuildables()
 			}
 		}
 
-		//sound.cfg
-		Com_sprintf( filename, sizeof( filename ), "sound/buildables/%s/sound.cfg", buildableName );
-
-		if ( !CG_ParseBuildableSoundFile( filename, (buildable_t) buildable ) )
-		{
-			Log::Warn( "failed to load sound file %s", filename );
-		}
-
 		//sounds
 		for ( j = BANIM_NONE + 1; j < MAX_BUILDABLE_ANIMATIONS; j++ )
 		{
@@ -704,7 +722,7 @@ void CG_InitBuildables()
 		}
 
 		cg.buildableLoadingFraction = ( float ) buildable / ( float )( BA_NUM_BUILDABLES - 1 );
-		trap_UpdateScreen();
+		CG_RefreshLoadingScreen();
 	}
 
 	cgs.media.reactorZapTS = CG_RegisterTrailSystem( "trails/weapons/reactor/lightning" );
@@ -822,7 +840,7 @@ static void CG_SetBuildableLerpFrameAnimation( buildable_t buildable, lerpFrame_
 		{
 			if ( lf->old_animation != nullptr && lf->old_animation->handle )
 			{
-				if ( !trap_R_BuildSkeleton( &oldbSkeleton, lf->old_animation->handle, lf->oldFrame, lf->frame, lf->blendlerp, lf->old_animation->clearOrigin ) )
+				if ( !CG_BuildSkeleton( &oldbSkeleton, lf->old_animation->handle, lf->oldFrame, lf->frame, lf->blendlerp, lf->old_animation->clearOrigin ) )
 				{
 					Log::Warn( "Can't build old buildable bSkeleton" );
 					return;
@@ -1154,7 +1172,7 @@ void CG_GhostBuildable( int buildableInfo )
 
 	if ( cg_buildables[ buildable ].md5 )
 	{
-		trap_R_BuildSkeleton( &ent.skeleton, cg_buildables[ buildable ].animations[ BANIM_IDLE1 ].handle, 0, 0, 0, false );
+		CG_BuildSkeleton( &ent.skeleton, cg_buildables[ buildable ].animations[ BANIM_IDLE1 ].handle, 0, 0, 0, false );
 		CG_TransformSkeleton( &ent.skeleton, scale );
 	}
 
@@ -1865,24 +1883,37 @@ static int CG_SortDistance( const centity_t *a, const centity_t *b )
 
 /*
 ==================
-CG_PlayerIsBuilder
+CG_BuilderTeam
+
+The team the player can build for, TEAM_NONE without a build weapon
 ==================
 */
-static bool CG_PlayerIsBuilder( buildable_t buildable )
+static team_t CG_BuilderTeam()
 {
 	switch ( cg.predictedPlayerState.weapon )
 	{
 		case WP_ABUILD:
 		case WP_ABUILD2:
 		case WP_HBUILD:
-			return BG_Buildable( buildable )->team ==
-			       BG_Weapon( cg.predictedPlayerState.weapon )->team;
+			return BG_Weapon( cg.predictedPlayerState.weapon )->team;
 
 		default:
-			return false;
+			return TEAM_NONE;
 	}
 }
 
+/*
+==================
+CG_PlayerIsBuilder
+==================
+*/
+static bool CG_PlayerIsBuilder( buildable_t buildable )
+{
+	team_t team = CG_BuilderTeam();
+
+	return team != TEAM_NONE && BG_Buildable( buildable )->team == team;
+}
+
 /*
 ==================
 CG_BuildableRemovalPending
@@ -1920,18 +1951,16 @@ or alien builder
 void CG_DrawBuildableStatus()
 {
 	BoundedVector<centity_t *, MAX_GENTITIES> buildableList;
+	team_t team = CG_BuilderTeam();
 
-	if ( !cg_drawBuildableHealth.Get() )
+	if ( !cg_drawBuildableHealth.Get() || team == TEAM_NONE )
 	{
 		return;
 	}
 
-	for ( entityState_t &es : cg.snap->entities )
+	for ( centity_t *cent : CG_BuildablesOfTeam( team ) )
 	{
-		if ( es.eType == entityType_t::ET_BUILDABLE && CG_PlayerIsBuilder( (buildable_t) es.modelindex ) )
-		{
-			buildableList.append(&cg_entities[ es.number ]);
-		}
+		buildableList.append( cent );
 	}
 
 	std::sort( buildableList.begin(), buildableList.end(), CG_SortDistance );
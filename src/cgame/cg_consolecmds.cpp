@@ -463,6 +463,7 @@ static const struct cg_cmd_t
 	{ "buy",              0,                       CG_CompleteBuy   },
 	{ "callteamvote",     0,                       CG_CompleteTeamVote },
 	{ "callvote",         0,                       CG_CompleteVote  },
+	{ "checkTranslationCatalog", Trans_CheckCatalog_f, 0             },
 	{ "class",            0,                       CG_CompleteClass },
 	{ "clientlist",       CG_ClientList_f,         0                },
 	{ "damage",           0,                       0                },
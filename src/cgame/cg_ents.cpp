@@ -976,6 +976,9 @@ CG_CalcEntityLerpPositions
 */
 static void CG_CalcEntityLerpPositions( centity_t *cent )
 {
+	// attachments may have asked for last frame's position already
+	CG_InvalidateCentTransform( cent->currentState.number );
+
 	// this will be set to how far forward projectiles will be extrapolated
 	int timeshift = 0;
 
@@ -179,8 +179,7 @@ struct attachment_t
 	vec3_t origin;
 
 	//AT_TAG
-	refEntity_t re; //FIXME: should be pointers?
-	refEntity_t parent; //
+	refEntity_t parent; //FIXME: should be a pointer?
 	qhandle_t   model;
 	char        tagName[ MAX_STRING_CHARS ];
 
@@ -189,6 +188,12 @@ struct attachment_t
 
 	//AT_PARTICLE
 	particle_t *particle;
+
+	//AT_TAG and AT_CENT transform, resolved once per frame, or per lerp for AT_CENT
+	int    resolvedFrame;
+	int    resolvedVersion;
+	vec3_t resolvedOrigin;
+	vec3_t resolvedAxis[ 3 ];
 };
 
 //======================================================================
@@ -352,6 +357,7 @@ struct baseParticle_t
 	bool    overdrawProtection;
 	bool    realLight;
 	bool    cullOnStartSolid;
+	bool    noBatching; // the shaders animate from the particle's birth
 
 	float       scaleWithCharge;
 };
@@ -411,6 +417,8 @@ struct particleEjector_t
 
 	int              nextEjectionTime;
 
+	int              numLiveParticles;
+
 	bool         valid;
 };
 
@@ -433,6 +441,12 @@ struct particle_t
 	vec3_t            origin;
 	vec3_t            velocity;
 
+	//last surface hit by a collision trace
+	bool              collisionPlaneValid;
+	vec3_t            collisionNormal;
+	float             collisionDist;
+	vec3_t            collisionOrigin;
+
 	pMoveType_t       accMoveType;
 	pMoveValues_t     accMoveValues;
 
@@ -454,6 +468,8 @@ struct particle_t
 	int               frameWhenInvalidated;
 
 	int               sortKey;
+	int               sortIndex;
+	int               storeIndex;
 };
 
 //======================================================================
@@ -1052,7 +1068,8 @@ struct minimap_t
 
 #define MAX_PREDICTED_EVENTS     16
 
-#define NUM_SAVED_STATES         ( CMD_BACKUP + 2 )
+// one checkpoint per command that can still be unacknowledged
+#define NUM_PREDICTION_CHECKPOINTS CMD_BACKUP
 
 // After this many msec the crosshair name fades out completely
 #define CROSSHAIR_CLIENT_TIMEOUT 1000
@@ -1088,6 +1105,15 @@ struct WeaponOffsets
 
 #define NUM_BINARY_SHADERS 256
 
+// player state after predicting a command, see CG_PredictPlayerState
+struct predictionCheckpoint_t
+{
+	int           cmdNum;
+	playerState_t ps;
+	pmoveExt_t    pmext;
+	bool          touchedTeleporter;
+};
+
 struct cg_t
 {
 	int      clientFrame; // incremented each frame
@@ -1264,8 +1290,8 @@ struct cg_t
 
 	int                     lastPredictedCommand;
 	int                     lastServerTime;
-	playerState_t           savedPmoveStates[ NUM_SAVED_STATES ];
-	int                     stateHead, stateTail;
+	predictionCheckpoint_t  predictionCheckpoints[ NUM_PREDICTION_CHECKPOINTS ];
+	int                     firstCheckpointCommand; // checkpoints from here to lastPredictedCommand are valid
 	int                     ping;
 
 	qhandle_t               lastHealthCross;
@@ -1294,7 +1320,8 @@ struct cg_t
 		int accurate;
 	} pmoveParams;
 
-	Filter<WeaponOffsets>   weaponOffsetsFilter;
+	// one sample per msec at most, enough for the 350 msec width
+	RingFilter<WeaponOffsets, 512> weaponOffsetsFilter;
 };
 
 enum rocketElementType_t
@@ -1314,6 +1341,60 @@ enum class rocketVarType_t {
 	ROCKET_COLOR
 };
 
+struct rocketDataValue_t
+{
+	rocketVarType_t type = rocketVarType_t::ROCKET_STRING;
+	int             intValue = 0;
+	float           floatValue = 0.0f;
+	std::string     stringValue;
+};
+
+/*
+ * A data source row of typed values, which the data grids store as they are
+ * instead of parsing them back out of an info string. Column names are not
+ * copied.
+ */
+class RocketDataRow
+{
+public:
+	RocketDataRow &Int( const char *column, int value )
+	{
+		rocketDataValue_t &cell = Add( column, rocketVarType_t::ROCKET_INT );
+		cell.intValue = value;
+		return *this;
+	}
+
+	RocketDataRow &Float( const char *column, float value )
+	{
+		rocketDataValue_t &cell = Add( column, rocketVarType_t::ROCKET_FLOAT );
+		cell.floatValue = value;
+		return *this;
+	}
+
+	RocketDataRow &String( const char *column, Str::StringRef value )
+	{
+		rocketDataValue_t &cell = Add( column, rocketVarType_t::ROCKET_STRING );
+		cell.stringValue.assign( value.data(), value.size() );
+		return *this;
+	}
+
+	const std::vector<std::pair<const char *, rocketDataValue_t>> &Values() const
+	{
+		return values;
+	}
+
+private:
+	rocketDataValue_t &Add( const char *column, rocketVarType_t type )
+	{
+		values.emplace_back();
+		values.back().first = column;
+		values.back().second.type = type;
+		return values.back().second;
+	}
+
+	std::vector<std::pair<const char *, rocketDataValue_t>> values;
+};
+
 enum rocketMenuType_t {
 	ROCKETMENU_MAIN,
 	ROCKETMENU_CONNECTING,
@@ -1355,6 +1436,7 @@ struct rocketMenu_t
 struct server_t
 {
 	char *name;
+	char *cleanName; // name without colors, for sorting and filtering
 	char *label;
 	int clients;
 	int bots;
@@ -1913,6 +1995,7 @@ void       CG_BuildSpectatorString();
 
 void       CG_UpdateBuildableRangeMarkerMask();
 void       CG_RegisterGrading( int slot, const char *str );
+void       CG_RefreshLoadingScreen();
 
 void CG_Init( int serverMessageNum, int clientNum, const glconfig_t& gl, const GameStateCSs& gameState );
 void CG_Shutdown();
@@ -2004,6 +2087,7 @@ void     CG_GhostBuildable( int buildableInfo );
 void     CG_Buildable( centity_t *cent );
 void     CG_BuildableStatusParse( const char *filename, buildStat_t *bs );
 void     CG_DrawBuildableStatus();
+void     CG_ParseBuildableConfigs();
 void     CG_InitBuildables();
 void     CG_HumanBuildableDying( buildable_t buildable, vec3_t origin );
 void     CG_HumanBuildableExplosion( buildable_t buildable, vec3_t origin, vec3_t dir );
@@ -2018,6 +2102,8 @@ int CG_AnimNumber( int anim );
 void CG_RunLerpFrame( lerpFrame_t *lf );
 void CG_RunMD5LerpFrame( lerpFrame_t *lf, bool animChanged );
 void CG_BlendLerpFrame( lerpFrame_t *lf );
+bool CG_BuildSkeleton( refSkeleton_t *skel, qhandle_t animation, int startFrame, int endFrame, float frac, bool clearOrigin );
+bool CG_BlendSkeleton( refSkeleton_t *skel, const refSkeleton_t *blend, float frac );
 void CG_BuildAnimSkeleton( const lerpFrame_t *lf, refSkeleton_t *newSkeleton, const refSkeleton_t *oldSkeleton );
 
 //
@@ -2131,6 +2217,13 @@ float CG_ChargeProgress();
 void CG_InitMinimap();
 void CG_DrawMinimap( const rectDef_t *rect, const Color::Color& color );
 
+//
+// cg_scenebatch.cpp
+//
+void CG_BatchPolys( qhandle_t shader, int numVerts, const polyVert_t *verts, int numPolys );
+bool CG_BatchSprite( qhandle_t shader, const vec3_t origin, float radius, float rotation, const byte color[ 4 ] );
+void CG_FlushSceneBatches();
+
 //
 // cg_marks.c
 //
@@ -2146,7 +2239,12 @@ void CG_ImpactMark( qhandle_t markShader,
 //
 // cg_snapshot.c
 //
+using centityList_t = BoundedVector<centity_t *, MAX_GENTITIES>;
+
 void CG_ProcessSnapshots();
+const centityList_t &CG_EntitiesOfType( entityType_t type );
+const centityList_t &CG_PlayersOfTeam( team_t team );
+const centityList_t &CG_BuildablesOfTeam( team_t team );
 
 //
 // cg_consolecmds.c
@@ -2196,6 +2294,7 @@ void     CG_SetAttachmentTag( attachment_t *a, refEntity_t *parent,
 void     CG_SetAttachmentParticle( attachment_t *a, particle_t *p );
 
 void     CG_SetAttachmentOffset( attachment_t *a, vec3_t v );
+void     CG_InvalidateCentTransform( int centNum );
 
 //
 // cg_particles.c
@@ -2344,8 +2443,11 @@ void Rocket_DocumentAction( const char *name, const char *action );
 bool Rocket_GetEvent(std::string& cmdText);
 void Rocket_DeleteEvent();
 void Rocket_RegisterDataSource( const char *name );
-void Rocket_DSAddRow( const char *name, const char *table, const char *data );
+int  Rocket_DSAddRow( const char *name, const char *table, const char *data );
 void Rocket_DSChangeRow( const char *name, const char *table, const int row, const char *data );
+int  Rocket_DSAddRow( const char *name, const char *table, const RocketDataRow &data );
+void Rocket_DSChangeRow( const char *name, const char *table, const int row, const RocketDataRow &data );
+void Rocket_DSInsertRow( const char *name, const char *table, const int row, const RocketDataRow &data );
 void Rocket_DSRemoveRow( const char *name, const char *table, const int row );
 void Rocket_DSClearTable( const char *name, const char *table );
 void Rocket_SetInnerRML( const char* text, int parseFlags );
@@ -2353,7 +2455,7 @@ void Rocket_SetInnerRMLRaw( const char* RML );
 void Rocket_QuakeToRMLBuffer( const char *in, char *out, int length );
 void Rocket_GetEventParameters( char *params, int length );
 void Rocket_RegisterDataFormatter( const char *name );
-void Rocket_DataFormatterRawData( int handle, char *name, int nameLength, char *data, int dataLength );
+const char *Rocket_DataFormatterRawData( int handle, const std::vector<std::string> **data );
 void Rocket_DataFormatterFormattedData( int handle, const char *data, bool parseQuake );
 void Rocket_GetElementTag( char *tag, int length );
 void Rocket_RegisterElement( const char *tag );
@@ -396,10 +396,61 @@ static const char *choose( const char *first, ... )
 	return ret;
 }
 
+static Log::Logger loadingLogger( "cgame.loading" );
+
+// progress within a loading step is redrawn at most this often
+static const int LOADING_SCREEN_REFRESH_MSEC = 50;
+
+static int         loadingScreenTime = 0;
+static int         loadingStartTime = 0;
+static const char  *loadingStepLabel = nullptr;
+static int         loadingStepStartTime = 0;
+
+/*
+======================
+CG_RefreshLoadingScreen
+
+Shows the progress made within a loading step. Drawing a frame can take
+longer than loading what is in between two calls, so it is throttled.
+======================
+*/
+void CG_RefreshLoadingScreen()
+{
+	int time = trap_Milliseconds();
+
+	if ( time - loadingScreenTime < LOADING_SCREEN_REFRESH_MSEC )
+	{
+		return;
+	}
+
+	loadingScreenTime = time;
+	trap_UpdateScreen();
+}
+
+/*
+======================
+CG_EndLoadingStep
+
+Reports how long the current loading step took
+======================
+*/
+static int CG_EndLoadingStep()
+{
+	int time = trap_Milliseconds();
+
+	if ( loadingStepLabel )
+	{
+		loadingLogger.Verbose( "%s: %d ms", loadingStepLabel, time - loadingStepStartTime );
+		loadingStepLabel = nullptr;
+	}
+
+	return time;
+}
+
 static void CG_UpdateMediaFraction( float fraction )
 {
 	cg.mediaLoadingFraction = fraction;
-	trap_UpdateScreen();
+	CG_RefreshLoadingScreen();
 }
 
 enum cgLoadingStep_t {
@@ -430,6 +481,14 @@ CG_UpdateLoadingProgress
 
 static void CG_UpdateLoadingProgress( int step, const char *label, const char* loadingText )
 {
+	loadingStepStartTime = CG_EndLoadingStep();
+	loadingStepLabel = label;
+
+	if ( step == LOAD_START )
+	{
+		loadingStartTime = loadingStepStartTime;
+	}
+
 	cg.loadingFraction = ( 1.0f * step ) / LOAD_DONE;
 
 	Q_strncpyz( cg.loadingText, loadingText, sizeof( cg.loadingText ) );
@@ -438,6 +497,7 @@ static void CG_UpdateLoadingProgress( int step, const char *label, const char* l
 
 	if( cg.loading )
 	{
+		loadingScreenTime = loadingStepStartTime;
 		trap_UpdateScreen();
 	}
 }
@@ -960,7 +1020,7 @@ static void CG_RegisterClients()
 			                       BG_ClassModelConfig( i )->skinName );
 
 			cg.characterLoadingFraction = ( float ) i / ( float ) PCL_NUM_CLASSES;
-			trap_UpdateScreen();
+			CG_RefreshLoadingScreen();
 		}
 	}
 
@@ -1298,6 +1358,7 @@ void CG_Init( int serverMessageNum, int clientNum, const glconfig_t& gl, const G
 	// disabledEquipment wouldn't be parsed correctly before
 	// loading the configs
 	CG_ParseServerinfo();
+	CG_ParseBuildableConfigs();
 
 	CG_UpdateLoadingStep( LOAD_SOUNDS );
 	CG_RegisterSounds();
@@ -1355,6 +1416,8 @@ void CG_Init( int serverMessageNum, int clientNum, const glconfig_t& gl, const G
 
 	trap_Cvar_Set( "ui_winner", "" ); // Clear the previous round's winner.
 
+	loadingLogger.Verbose( "CG_Init: %d ms in total", CG_EndLoadingStep() - loadingStartTime );
+
 	// Request server to resend pmoveParams.
 	trap_SendClientCommand( "client_ready" );
 }
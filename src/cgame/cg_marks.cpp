@@ -228,7 +228,7 @@ void CG_ImpactMark( qhandle_t markShader, const vec3_t origin, const vec3_t dir,
 		// if it is a temporary (shadow) mark, add it immediately and forget about it
 		if ( temporary )
 		{
-			trap_R_AddPolyToScene( markShader, mf->numPoints, verts );
+			CG_BatchPolys( markShader, mf->numPoints, verts, 1 );
 			continue;
 		}
 
@@ -306,6 +306,6 @@ void CG_AddMarks()
 				}
 			}
 		}
-		trap_R_AddPolyToScene( mp->markShader, mp->poly.numVerts, mp->verts );
+		CG_BatchPolys( mp->markShader, mp->poly.numVerts, mp->verts, 1 );
 	}
 }
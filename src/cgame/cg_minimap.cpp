@@ -258,6 +258,16 @@ static float transformVector[2];
 static float transformAngle;
 static float transformScale;
 
+//What the transform was computed from, it is kept as long as they don't change
+static struct
+{
+    rectDef_t            rect;
+    const minimapZone_t* zone;
+    float                yaw;
+    vec3_t               origin;
+    bool                 valid;
+} transformInputs;
+
 /*
 ================
 CG_SetupMinimapTransform
@@ -269,6 +279,21 @@ static void CG_SetupMinimapTransform( const rectDef_t *rect, const minimap_t* mi
 
     Q_UNUSED(minimap);
 
+    if( transformInputs.valid &&
+        transformInputs.zone == zone &&
+        transformInputs.yaw == cg.refdefViewAngles[1] &&
+        VectorCompare( transformInputs.origin, cg.refdef.vieworg ) &&
+        !memcmp( &transformInputs.rect, rect, sizeof( rectDef_t ) ) )
+    {
+        return;
+    }
+
+    transformInputs.rect = *rect;
+    transformInputs.zone = zone;
+    transformInputs.yaw = cg.refdefViewAngles[1];
+    VectorCopy( cg.refdef.vieworg, transformInputs.origin );
+    transformInputs.valid = true;
+
     //The refdefview angle is the angle from the x axis
     //the 90 gets it back to the Y axis (we want the view to point up)
     //and the orientation change gives the -
@@ -337,6 +362,146 @@ static float CG_WorldToMinimapScale( const float scale )
 }
 
 
+//The minimap is drawn from quads that are kept from one frame to the next,
+//the vertices of a quad are only rebuilt when its image, place or color changed
+struct minimapQuad_t
+{
+    qhandle_t image;
+    float     x, y, w, h, angle;
+    byte      color[4];
+};
+
+struct minimapLayer_t
+{
+    std::vector<minimapQuad_t> quads;
+    std::vector<polyVert_t>    verts;
+    size_t                     numQuads;
+};
+
+//The background, map and player are drawn inside the scissor, the beacons aren't
+static minimapLayer_t mapLayer;
+static minimapLayer_t beaconLayer;
+
+//Two triangles for every quad, shared by all the layers
+static std::vector<int> quadIndexes;
+
+/*
+================
+CG_MinimapBuildQuad
+
+Places the vertices like trap_R_DrawRotatedPic does
+================
+*/
+static void CG_MinimapBuildQuad( const minimapQuad_t* q, polyVert_t* verts )
+{
+    float mx, my, cw, ch, sw, sh;
+    int i;
+
+    mx = q->x + q->w / 2;
+    my = q->y + q->h / 2;
+    cw = cosf( DEG2RAD( q->angle ) ) * ( q->w / 2 );
+    ch = cosf( DEG2RAD( q->angle ) ) * ( q->h / 2 );
+    sw = sinf( DEG2RAD( q->angle ) ) * ( q->w / 2 );
+    sh = sinf( DEG2RAD( q->angle ) ) * ( q->h / 2 );
+
+    verts[0].xyz[0] = mx - cw - sh;
+    verts[0].xyz[1] = my + sw - ch;
+    verts[0].st[0] = 0.0f;
+    verts[0].st[1] = 0.0f;
+
+    verts[1].xyz[0] = mx + cw - sh;
+    verts[1].xyz[1] = my - sw - ch;
+    verts[1].st[0] = 1.0f;
+    verts[1].st[1] = 0.0f;
+
+    verts[2].xyz[0] = mx + cw + sh;
+    verts[2].xyz[1] = my - sw + ch;
+    verts[2].st[0] = 1.0f;
+    verts[2].st[1] = 1.0f;
+
+    verts[3].xyz[0] = mx - cw + sh;
+    verts[3].xyz[1] = my + sw + ch;
+    verts[3].st[0] = 0.0f;
+    verts[3].st[1] = 1.0f;
+
+    for( i = 0; i < 4; i++ )
+    {
+        verts[i].xyz[2] = 0.0f;
+        memcpy( verts[i].modulate, q->color, sizeof( verts[i].modulate ) );
+    }
+}
+
+/*
+================
+CG_MinimapAddQuad
+
+Uses the next quad of the layer, rebuilding it only if it differs from the
+quad that was there last frame
+================
+*/
+static void CG_MinimapAddQuad( minimapLayer_t* layer, const qhandle_t image, const float x, const float y, const float w, const float h, const float angle, const Color::Color& color )
+{
+    minimapQuad_t q;
+    Color::Color32Bit color32 = color;
+    size_t n = layer->numQuads++;
+
+    q.image = image;
+    q.x = x;
+    q.y = y;
+    q.w = w;
+    q.h = h;
+    q.angle = angle;
+    memcpy( q.color, color32.ToArray(), sizeof( q.color ) );
+
+    if( n == layer->quads.size() )
+    {
+        layer->quads.push_back( q );
+        layer->verts.resize( 4 * layer->quads.size() );
+    }
+    else if( !memcmp( &layer->quads[n], &q, sizeof( q ) ) )
+    {
+        return;
+    }
+    else
+    {
+        layer->quads[n] = q;
+    }
+
+    CG_MinimapBuildQuad( &q, &layer->verts[4 * n] );
+}
+
+/*
+================
+CG_MinimapSubmitLayer
+
+Draws the quads added this frame, with one call for every run of quads using
+the same image as the renderer takes a single shader per call
+================
+*/
+static void CG_MinimapSubmitLayer( minimapLayer_t* layer )
+{
+    size_t first, last;
+
+    while( quadIndexes.size() < 6 * layer->numQuads )
+    {
+        int base = 4 * ( quadIndexes.size() / 6 );
+
+        quadIndexes.insert( quadIndexes.end(), { base, base + 1, base + 2, base, base + 2, base + 3 } );
+    }
+
+    for( first = 0; first < layer->numQuads; first = last )
+    {
+        qhandle_t image = layer->quads[first].image;
+
+        for( last = first + 1; last < layer->numQuads && layer->quads[last].image == image; last++ );
+
+        trap_R_Add2dPolysIndexedToScene( &layer->verts[4 * first], 4 * ( last - first ),
+                                         quadIndexes.data(), 6 * ( last - first ), 0, 0, image );
+    }
+
+    layer->numQuads = 0;
+}
+
 /*
 ================
 CG_SetMinimapColor
@@ -368,9 +533,8 @@ static void CG_DrawMinimapObject( const qhandle_t image, const vec3_t pos3d, con
 
     //Handle teamcolor + transparency
     currentMinimapColor.SetAlpha( alpha );
-    trap_R_SetColor( currentMinimapColor );
 
-    trap_R_DrawRotatedPic( x, y, wh, wh, 0.0, 0.0, 1.0, 1.0, image, realAngle );
+    CG_MinimapAddQuad( &mapLayer, image, x, y, wh, wh, realAngle, currentMinimapColor );
 }
 
 /*
@@ -578,22 +742,21 @@ static void CG_MinimapDrawBeacon( const cbeacon_t *b, float size, const vec2_t c
 
 	Color::Color color = b->color;
 	color.SetAlpha( cgs.bc.minimapAlpha );
-	trap_R_SetColor( color );
 
-	trap_R_DrawRotatedPic( pos2d[ 0 ], pos2d[ 1 ], size, size, 0.0f, 0.0f, 1.0f, 1.0f, CG_BeaconIcon( b ), 0.0f );
+	CG_MinimapAddQuad( &beaconLayer, CG_BeaconIcon( b ), pos2d[ 0 ], pos2d[ 1 ], size, size, 0.0f, color );
 	if( b->flags & EF_BC_DYING )
-		trap_R_DrawStretchPic( pos2d[ 0 ] - size/2 * 0.3f,
-		                       pos2d[ 1 ] - size/2 * 0.3f,
-		                       size * 1.3, size * 1.3f,
-		                       0, 0, 1, 1,
-		                       cgs.media.beaconNoTarget );
+		CG_MinimapAddQuad( &beaconLayer, cgs.media.beaconNoTarget,
+		                   pos2d[ 0 ] - size/2 * 0.3f,
+		                   pos2d[ 1 ] - size/2 * 0.3f,
+		                   size * 1.3f, size * 1.3f,
+		                   0.0f, color );
 	if( clamped )
-		trap_R_DrawRotatedPic( pos2d[ 0 ] - size * 0.25f,
-		                       pos2d[ 1 ] - size * 0.25f,
-		                       size * 1.5, size * 1.5f,
-		                       0.0f, 0.0f, 1.0f, 1.0f,
-		                       cgs.media.beaconIconArrow,
-		                       270.0f - atan2f( dir[ 1 ], dir[ 0 ] ) * 180 / M_PI );
+		CG_MinimapAddQuad( &beaconLayer, cgs.media.beaconIconArrow,
+		                   pos2d[ 0 ] - size * 0.25f,
+		                   pos2d[ 1 ] - size * 0.25f,
+		                   size * 1.5f, size * 1.5f,
+		                   270.0f - atan2f( dir[ 1 ], dir[ 0 ] ) * 180 / M_PI,
+		                   color );
 }
 
 /*
@@ -651,6 +814,9 @@ void CG_InitMinimap()
     m->gfx.playerArrow = trap_R_RegisterShader( "gfx/feedback/minimap/player-arrow", (RegisterShaderFlags_t) ( RSF_NOMIP ) );
     m->gfx.teamArrow = trap_R_RegisterShader( "gfx/feedback/minimap/team-arrow", (RegisterShaderFlags_t) ( RSF_NOMIP ) );
 
+    //The zones were parsed again
+    transformInputs.valid = false;
+
     CG_UpdateMinimapActive( m );
 }
 
@@ -681,21 +847,19 @@ void CG_DrawMinimap( const rectDef_t* rect640, const Color::Color& teamColor )
     CG_SetMinimapColor( teamColor );
 
     //Add the backgound
-    CG_FillRect( rect640->x, rect640->y, rect640->w, rect640->h, m->bgColor );
+    CG_MinimapAddQuad( &mapLayer, cgs.media.whiteShader, rect.x, rect.y, rect.w, rect.h, 0.0f, m->bgColor );
+
+    CG_MinimapDrawMap( m, z );
+    CG_MinimapDrawPlayer( m );
+    //CG_MinimapDrawTeammates( m );
 
     //Draw things inside the rectangle we were given
     CG_SetScissor( rect.x, rect.y, rect.w, rect.h );
     CG_EnableScissor( true );
-    {
-        CG_MinimapDrawMap( m, z );
-        CG_MinimapDrawPlayer( m );
-        //CG_MinimapDrawTeammates( m );
-    }
+    CG_MinimapSubmitLayer( &mapLayer );
     CG_EnableScissor( false );
 
 		//(experimental) Draw beacons without the scissor
     CG_MinimapDrawBeacons( &rect );
-
-    //Reset the color for other hud elements
-    trap_R_ClearColor();
+    CG_MinimapSubmitLayer( &beaconLayer );
 }
@@ -0,0 +1,190 @@
+/*
+===========================================================================
+
+Unvanquished GPL Source Code
+Copyright (C) 2022 Unvanquished Developers
+
+This file is part of the Unvanquished GPL Source Code (Unvanquished Source Code).
+
+Unvanquished is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Unvanquished is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Unvanquished.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+#include "cg_particle_kernel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#define PARTICLE_KERNEL_SSE2
+#include <emmintrin.h>
+#endif
+
+/*
+ * The scalar versions are used for the tail of every stream and on platforms
+ * without SSE2. They are written to give the same results as the SIMD paths,
+ * including the min/max semantics for NaN.
+ */
+
+static inline float Clamp01( float f )
+{
+	f = f > 0.0f ? f : 0.0f;
+	return f < 1.0f ? f : 1.0f;
+}
+
+static void IntegrateScalar( int i, int count, const float *p, float *v, const float *a, const float *dt, float *n )
+{
+	for ( ; i < count; i++ )
+	{
+		v[ i ] = v[ i ] + dt[ i ] * a[ i ];
+		n[ i ] = p[ i ] + dt[ i ] * v[ i ];
+	}
+}
+
+static void EvaluateCurvesScalar( int i, int count, float time, const float *start, const float *duration,
+                                  const float *initial, const float *final, float *value )
+{
+	for ( ; i < count; i++ )
+	{
+		float frac = Clamp01( ( time - start[ i ] ) / duration[ i ] );
+
+		value[ i ] = initial[ i ] + frac * ( final[ i ] - initial[ i ] );
+	}
+}
+
+void CG_IntegrateParticles( int count, const float *const pos[ 3 ], float *const vel[ 3 ],
+                            const float *const acc[ 3 ], const float *dt, float *const newPos[ 3 ] )
+{
+	for ( int axis = 0; axis < 3; axis++ )
+	{
+		const float *p = pos[ axis ];
+		const float *a = acc[ axis ];
+		float       *v = vel[ axis ];
+		float       *n = newPos[ axis ];
+		int         i = 0;
+
+#ifdef PARTICLE_KERNEL_SSE2
+		for ( ; i + 4 <= count; i += 4 )
+		{
+			__m128 t  = _mm_loadu_ps( dt + i );
+			__m128 vi = _mm_add_ps( _mm_loadu_ps( v + i ), _mm_mul_ps( t, _mm_loadu_ps( a + i ) ) );
+
+			_mm_storeu_ps( v + i, vi );
+			_mm_storeu_ps( n + i, _mm_add_ps( _mm_loadu_ps( p + i ), _mm_mul_ps( t, vi ) ) );
+		}
+#endif
+
+		IntegrateScalar( i, count, p, v, a, dt, n );
+	}
+}
+
+void CG_EvaluateParticleCurves( int count, float time, const float *start, const float *duration,
+                                const float *initial, const float *final, float *value )
+{
+	int i = 0;
+
+#ifdef PARTICLE_KERNEL_SSE2
+	const __m128 t    = _mm_set1_ps( time );
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one  = _mm_set1_ps( 1.0f );
+
+	for ( ; i + 4 <= count; i += 4 )
+	{
+		__m128 frac = _mm_div_ps( _mm_sub_ps( t, _mm_loadu_ps( start + i ) ), _mm_loadu_ps( duration + i ) );
+		frac = _mm_min_ps( _mm_max_ps( frac, zero ), one );
+
+		__m128 a = _mm_loadu_ps( initial + i );
+		__m128 b = _mm_loadu_ps( final + i );
+
+		_mm_storeu_ps( value + i, _mm_add_ps( a, _mm_mul_ps( frac, _mm_sub_ps( b, a ) ) ) );
+	}
+#endif
+
+	EvaluateCurvesScalar( i, count, time, start, duration, initial, final, value );
+}
+
+bool CG_ParticleKernelsUseSSE2()
+{
+#ifdef PARTICLE_KERNEL_SSE2
+	return true;
+#else
+	return false;
+#endif
+}
+
+float CG_TestParticleKernels( int maxCount, unsigned seed )
+{
+	float maxError = 0.0f;
+
+	// a small LCG, so that a seed gives the same streams everywhere
+	auto random = [ &seed ]( float min, float max ) {
+		seed = seed * 1664525u + 1013904223u;
+		return min + ( max - min ) * ( ( seed >> 8 ) * ( 1.0f / 16777216.0f ) );
+	};
+
+	auto compare = [ &maxError ]( const std::vector<float> &a, const std::vector<float> &b ) {
+		for ( size_t i = 0; i < a.size(); i++ )
+		{
+			float error = std::fabs( a[ i ] - b[ i ] ) / std::max( 1.0f, std::fabs( b[ i ] ) );
+			maxError = std::isnan( error ) ? INFINITY : std::max( maxError, error );
+		}
+	};
+
+	// every length up to maxCount, so that all the scalar tails are covered
+	for ( int count = 1; count <= maxCount; count++ )
+	{
+		std::vector<float> pos( count ), vel( count ), acc( count ), dt( count ), duration( count );
+
+		for ( int i = 0; i < count; i++ )
+		{
+			pos[ i ] = random( -4096.0f, 4096.0f );
+			vel[ i ] = random( -1000.0f, 1000.0f );
+			acc[ i ] = random( -800.0f, 800.0f );
+			dt[ i ] = random( 0.0f, 0.1f );
+			duration[ i ] = random( 1.0f, 5000.0f );
+		}
+
+		// the same streams stand in for all three axes
+		std::vector<float> kernelVel[ 3 ] = { vel, vel, vel }, kernelPos[ 3 ];
+		std::vector<float> scalarVel = vel, scalarPos( count );
+
+		for ( std::vector<float> &stream : kernelPos ) stream.resize( count );
+
+		const float *const posIn[ 3 ] = { pos.data(), pos.data(), pos.data() };
+		const float *const accIn[ 3 ] = { acc.data(), acc.data(), acc.data() };
+		float *const velOut[ 3 ] = { kernelVel[ 0 ].data(), kernelVel[ 1 ].data(), kernelVel[ 2 ].data() };
+		float *const posOut[ 3 ] = { kernelPos[ 0 ].data(), kernelPos[ 1 ].data(), kernelPos[ 2 ].data() };
+
+		CG_IntegrateParticles( count, posIn, velOut, accIn, dt.data(), posOut );
+		IntegrateScalar( 0, count, pos.data(), scalarVel.data(), acc.data(), dt.data(), scalarPos.data() );
+
+		for ( int axis = 0; axis < 3; axis++ )
+		{
+			compare( kernelVel[ axis ], scalarVel );
+			compare( kernelPos[ axis ], scalarPos );
+		}
+
+		// start times around the evaluation time, so that the clamping is exercised
+		float time = random( -1000.0f, 6000.0f );
+		std::vector<float> kernelValue( count ), scalarValue( count );
+
+		CG_EvaluateParticleCurves( count, time, pos.data(), duration.data(), vel.data(), acc.data(), kernelValue.data() );
+		EvaluateCurvesScalar( 0, count, time, pos.data(), duration.data(), vel.data(), acc.data(), scalarValue.data() );
+
+		compare( kernelValue, scalarValue );
+	}
+
+	return maxError;
+}
@@ -0,0 +1,64 @@
+/*
+===========================================================================
+
+Unvanquished GPL Source Code
+Copyright (C) 2022 Unvanquished Developers
+
+This file is part of the Unvanquished GPL Source Code (Unvanquished Source Code).
+
+Unvanquished is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Unvanquished is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Unvanquished.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+
+#ifndef CG_PARTICLE_KERNEL_H
+#define CG_PARTICLE_KERNEL_H
+
+/*
+ * Data-parallel parts of the particle simulation.
+ *
+ * These work on plain structure-of-arrays float streams so that they can run
+ * over all live particles in one pass, four at a time with SSE2 if available.
+ * They don't depend on the rest of the cgame.
+ */
+
+/**
+ * @brief Integrates velocity and position over a time step:
+ *        vel += acc * dt, newPos = pos + vel * dt
+ *
+ * Every argument except count and dt is an array of three streams (x, y, z).
+ */
+void CG_IntegrateParticles( int count, const float *const pos[ 3 ], float *const vel[ 3 ],
+                            const float *const acc[ 3 ], const float *dt, float *const newPos[ 3 ] );
+
+/**
+ * @brief Evaluates a delayed linear curve at the given time:
+ *        value = initial + clamp( ( time - start ) / duration, 0, 1 ) * ( final - initial )
+ */
+void CG_EvaluateParticleCurves( int count, float time, const float *start, const float *duration,
+                                const float *initial, const float *final, float *value );
+
+/**
+ * @brief Whether the kernels were built with their SSE2 paths.
+ */
+bool CG_ParticleKernelsUseSSE2();
+
+/**
+ * @brief Compares the kernels with their scalar versions on pseudo-random
+ *        streams of every length from 1 to maxCount.
+ * @return The largest relative difference found, 0 if they agree exactly.
+ */
+float CG_TestParticleKernels( int maxCount, unsigned seed );
+
+#endif // CG_PARTICLE_KERNEL_H
@@ -27,9 +27,23 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include "common/FileSystem.h"
 #include "cg_local.h"
+#include "cg_particle_kernel.h"
 
 static Log::Logger logger("cgame.particles", "[Particle Systems]");
 
+static Cvar::Range<Cvar::Cvar<int>> cg_particleTraceBudget(
+	"cg_particleTraceBudget", "maximum particle collision traces per frame, 0 for no limit", Cvar::NONE,
+	256, 0, 65536 );
+static Cvar::Cvar<float> cg_particleTraceTolerance(
+	"cg_particleTraceTolerance", "distance a particle may move away from its last trace while "
+	"reusing the surface it hit", Cvar::NONE, 8.0f );
+static Cvar::Cvar<float> cg_particleFarCollisionDistance(
+	"cg_particleFarCollisionDistance", "distance from the view beyond which particle collisions "
+	"are updated at a lower rate", Cvar::NONE, 1024.0f );
+
+// how often particles beyond cg_particleFarCollisionDistance trace their motion
+#define PARTICLE_FAR_COLLISION_PERIOD 100
+
 static baseParticleSystem_t  baseParticleSystems[ MAX_BASEPARTICLE_SYSTEMS ];
 static baseParticleEjector_t baseParticleEjectors[ MAX_BASEPARTICLE_EJECTORS ];
 static baseParticle_t        baseParticles[ MAX_BASEPARTICLES ];
@@ -40,8 +54,58 @@ static int                   numBaseParticles = 0;
 static particleSystem_t      particleSystems[ MAX_PARTICLE_SYSTEMS ];
 static particleEjector_t     particleEjectors[ MAX_PARTICLE_EJECTORS ];
 static particle_t            particles[ MAX_PARTICLES ];
+// All live particles, back to front as of the last CG_SortParticles.
+// Dead particles leave a nullptr behind until the next sort.
 static particle_t            *sortedParticles[ MAX_PARTICLES ];
-static particle_t            *radixBuffer[ MAX_PARTICLES ];
+static int                   numSortedParticles = 0;
+
+// Free particle slots in the order they were released, so the slot at the
+// head is always the one that has been free for the longest time.
+static int                   freeParticles[ MAX_PARTICLES ];
+static int                   freeParticlesHead = 0;
+static int                   numFreeParticles = 0;
+
+enum particleCurve_t
+{
+	PC_RADIUS,
+	PC_ALPHA,
+	PC_ROTATION,
+	PC_DLIGHT_RADIUS,
+	PC_COLOR, // fraction of the color fade
+	PC_LIFE,  // fraction of the life time
+
+	PC_NUM
+};
+
+// Dense structure-of-arrays copy of the per-frame state of all live particles,
+// so the kernels in cg_particle_kernel.cpp can evaluate them in one pass.
+// Indexed by particle_t::storeIndex.
+static struct
+{
+	int        count;
+	particle_t *owner[ MAX_PARTICLES ];
+
+	bool       stepped[ MAX_PARTICLES ]; // moved by the kernel this frame
+	float      deltaTime[ MAX_PARTICLES ];
+	float      origin[ 3 ][ MAX_PARTICLES ];
+	float      velocity[ 3 ][ MAX_PARTICLES ];
+	float      acceleration[ 3 ][ MAX_PARTICLES ];
+	float      newOrigin[ 3 ][ MAX_PARTICLES ];
+
+	float      curveStart[ PC_NUM ][ MAX_PARTICLES ];
+	float      curveDuration[ PC_NUM ][ MAX_PARTICLES ];
+	float      curveInitial[ PC_NUM ][ MAX_PARTICLES ];
+	float      curveFinal[ PC_NUM ][ MAX_PARTICLES ];
+	float      curveValue[ PC_NUM ][ MAX_PARTICLES ];
+} particleStore;
+
+// Collision traces made this frame, see cg_particleTraceBudget.
+static int                   numParticleTraces = 0;
+
+// The order in which particle physics are run, rotated so that particles that
+// ran out of trace budget go first in the next frame.
+static particle_t            *physicsOrder[ MAX_PARTICLES ];
+static int                   physicsCursor = 0;
 
 /*
 ===============
@@ -103,6 +167,154 @@ static void CG_SpreadVector( vec3_t v, float spread )
 	VectorCopy( r2, v );
 }
 
+/*
+===============
+CG_InitParticlePool
+
+Put all unused particle slots on the free list
+===============
+*/
+static void CG_InitParticlePool()
+{
+	freeParticlesHead = 0;
+	numFreeParticles = 0;
+
+	for ( int i = 0; i < MAX_PARTICLES; i++ )
+	{
+		if ( !particles[ i ].valid )
+		{
+			freeParticles[ numFreeParticles++ ] = i;
+		}
+	}
+}
+
+/*
+===============
+CG_ReleaseParticle
+
+Return a particle slot to the free list
+===============
+*/
+static void CG_ReleaseParticle( particle_t *p )
+{
+	freeParticles[ ( freeParticlesHead + numFreeParticles ) % MAX_PARTICLES ] = p - particles;
+	numFreeParticles++;
+}
+
+/*
+===============
+CG_AllocParticle
+
+Take the oldest free particle slot, if it has been free for long enough
+===============
+*/
+static particle_t *CG_AllocParticle()
+{
+	if ( !numFreeParticles )
+	{
+		return nullptr;
+	}
+
+	particle_t *p = &particles[ freeParticles[ freeParticlesHead ] ];
+
+	//all other free slots were released later than this one
+	//FIXME: the + 1 may be unnecessary
+	if ( cg.clientFrame <= p->frameWhenInvalidated + 1 )
+	{
+		return nullptr;
+	}
+
+	freeParticlesHead = ( freeParticlesHead + 1 ) % MAX_PARTICLES;
+	numFreeParticles--;
+
+	return p;
+}
+
+/*
+===============
+CG_SetParticleCurve
+
+Set up a lerp value that starts after a delay and
+ends with the particle's life, see CG_LerpValues
+===============
+*/
+static void CG_SetParticleCurve( int index, particleCurve_t curve, const particle_t *p,
+                                 int delay, float initial, float final )
+{
+	particleStore.curveStart[ curve ][ index ] = ( float )( p->birthTime + delay );
+	particleStore.curveDuration[ curve ][ index ] = ( float )( p->lifeTime - delay );
+	particleStore.curveInitial[ curve ][ index ] = initial;
+	particleStore.curveFinal[ curve ][ index ] = ( final == PARTICLES_SAME_AS_INITIAL ) ? initial : final;
+}
+
+/*
+===============
+CG_AddParticleToStore
+
+Append a new particle to the structure-of-arrays store
+===============
+*/
+static void CG_AddParticleToStore( particle_t *p )
+{
+	int index = particleStore.count++;
+
+	particleStore.owner[ index ] = p;
+	p->storeIndex = index;
+
+	particleStore.stepped[ index ] = false;
+
+	CG_SetParticleCurve( index, PC_RADIUS, p, p->radius.delay, p->radius.initial, p->radius.final );
+	CG_SetParticleCurve( index, PC_ALPHA, p, p->alpha.delay, p->alpha.initial, p->alpha.final );
+	CG_SetParticleCurve( index, PC_ROTATION, p, p->rotation.delay, p->rotation.initial, p->rotation.final );
+	CG_SetParticleCurve( index, PC_DLIGHT_RADIUS, p, p->dLightRadius.delay,
+	                     p->dLightRadius.initial, p->dLightRadius.final );
+	CG_SetParticleCurve( index, PC_COLOR, p, p->colorDelay, 0.0f, 1.0f );
+	CG_SetParticleCurve( index, PC_LIFE, p, 0, 0.0f, 1.0f );
+}
+
+/*
+===============
+CG_RemoveParticleFromStore
+
+Fill the hole left by a particle with the last one in the store
+===============
+*/
+static void CG_RemoveParticleFromStore( particle_t *p )
+{
+	int index = p->storeIndex;
+	int last = --particleStore.count;
+
+	if ( index == last )
+	{
+		return;
+	}
+
+	particle_t *moved = particleStore.owner[ last ];
+
+	particleStore.owner[ index ] = moved;
+	moved->storeIndex = index;
+
+	particleStore.stepped[ index ] = particleStore.stepped[ last ];
+	particleStore.deltaTime[ index ] = particleStore.deltaTime[ last ];
+
+	for ( int axis = 0; axis < 3; axis++ )
+	{
+		particleStore.origin[ axis ][ index ] = particleStore.origin[ axis ][ last ];
+		particleStore.velocity[ axis ][ index ] = particleStore.velocity[ axis ][ last ];
+		particleStore.acceleration[ axis ][ index ] = particleStore.acceleration[ axis ][ last ];
+		particleStore.newOrigin[ axis ][ index ] = particleStore.newOrigin[ axis ][ last ];
+	}
+
+	for ( int curve = 0; curve < PC_NUM; curve++ )
+	{
+		particleStore.curveStart[ curve ][ index ] = particleStore.curveStart[ curve ][ last ];
+		particleStore.curveDuration[ curve ][ index ] = particleStore.curveDuration[ curve ][ last ];
+		particleStore.curveInitial[ curve ][ index ] = particleStore.curveInitial[ curve ][ last ];
+		particleStore.curveFinal[ curve ][ index ] = particleStore.curveFinal[ curve ][ last ];
+		particleStore.curveValue[ curve ][ index ] = particleStore.curveValue[ curve ][ last ];
+	}
+}
+
 /*
 ===============
 CG_DestroyParticle
@@ -130,10 +342,15 @@ static void CG_DestroyParticle( particle_t *p, vec3_t impactNormal )
 	}
 
 	p->valid = false;
+	p->parent->numLiveParticles--;
+	CG_RemoveParticleFromStore( p );
+	sortedParticles[ p->sortIndex ] = nullptr;
 
 	//this gives other systems a couple of
 	//frames to realise the particle is gone
 	p->frameWhenInvalidated = cg.clientFrame;
+
+	CG_ReleaseParticle( p );
 }
 
 /*
@@ -148,228 +365,231 @@ static particle_t *CG_SpawnNewParticle( baseParticle_t *bp, particleEjector_t *p
 	particleEjector_t *pe = parent;
 	particleSystem_t  *ps = parent->parent;
 
-	for ( int i = 0; i < MAX_PARTICLES; i++ )
+	particle_t *p = CG_AllocParticle();
+
+	if ( !p )
 	{
-		particle_t *p = &particles[ i ];
+		logger.Notice( "MAX_PARTICLES hit" );
+		return nullptr;
+	}
 
-		//FIXME: the + 1 may be unnecessary
-		if ( !p->valid && cg.clientFrame > p->frameWhenInvalidated + 1 )
-		{
-			memset( p, 0, sizeof( particle_t ) );
+	memset( p, 0, sizeof( particle_t ) );
+	p->class_ = bp;
+	p->parent = pe;
 
-			//found a free slot
-			p->class_ = bp;
-			p->parent = pe;
+	p->birthTime = cg.time;
+	p->lifeTime = ( int ) CG_RandomiseValue( ( float ) bp->lifeTime, bp->lifeTimeRandFrac );
 
-			p->birthTime = cg.time;
-			p->lifeTime = ( int ) CG_RandomiseValue( ( float ) bp->lifeTime, bp->lifeTimeRandFrac );
+	p->radius.delay = ( int ) CG_RandomiseValue( ( float ) bp->radius.delay, bp->radius.delayRandFrac );
+	p->radius.initial = CG_RandomiseValue( bp->radius.initial, bp->radius.initialRandFrac );
+	p->radius.final = CG_RandomiseValue( bp->radius.final, bp->radius.finalRandFrac );
 
-			p->radius.delay = ( int ) CG_RandomiseValue( ( float ) bp->radius.delay, bp->radius.delayRandFrac );
-			p->radius.initial = CG_RandomiseValue( bp->radius.initial, bp->radius.initialRandFrac );
-			p->radius.final = CG_RandomiseValue( bp->radius.final, bp->radius.finalRandFrac );
+	p->radius.initial += bp->scaleWithCharge * pe->parent->charge;
 
-			p->radius.initial += bp->scaleWithCharge * pe->parent->charge;
+	p->alpha.delay = ( int ) CG_RandomiseValue( ( float ) bp->alpha.delay, bp->alpha.delayRandFrac );
+	p->alpha.initial = CG_RandomiseValue( bp->alpha.initial, bp->alpha.initialRandFrac );
+	p->alpha.final = CG_RandomiseValue( bp->alpha.final, bp->alpha.finalRandFrac );
 
-			p->alpha.delay = ( int ) CG_RandomiseValue( ( float ) bp->alpha.delay, bp->alpha.delayRandFrac );
-			p->alpha.initial = CG_RandomiseValue( bp->alpha.initial, bp->alpha.initialRandFrac );
-			p->alpha.final = CG_RandomiseValue( bp->alpha.final, bp->alpha.finalRandFrac );
+	p->rotation.delay = ( int ) CG_RandomiseValue( ( float ) bp->rotation.delay, bp->rotation.delayRandFrac );
+	p->rotation.initial = CG_RandomiseValue( bp->rotation.initial, bp->rotation.initialRandFrac );
+	p->rotation.final = CG_RandomiseValue( bp->rotation.final, bp->rotation.finalRandFrac );
 
-			p->rotation.delay = ( int ) CG_RandomiseValue( ( float ) bp->rotation.delay, bp->rotation.delayRandFrac );
-			p->rotation.initial = CG_RandomiseValue( bp->rotation.initial, bp->rotation.initialRandFrac );
-			p->rotation.final = CG_RandomiseValue( bp->rotation.final, bp->rotation.finalRandFrac );
+	p->dLightRadius.delay =
+	  ( int ) CG_RandomiseValue( ( float ) bp->dLightRadius.delay, bp->dLightRadius.delayRandFrac );
+	p->dLightRadius.initial =
+	  CG_RandomiseValue( bp->dLightRadius.initial, bp->dLightRadius.initialRandFrac );
+	p->dLightRadius.final =
+	  CG_RandomiseValue( bp->dLightRadius.final, bp->dLightRadius.finalRandFrac );
 
-			p->dLightRadius.delay =
-			  ( int ) CG_RandomiseValue( ( float ) bp->dLightRadius.delay, bp->dLightRadius.delayRandFrac );
-			p->dLightRadius.initial =
-			  CG_RandomiseValue( bp->dLightRadius.initial, bp->dLightRadius.initialRandFrac );
-			p->dLightRadius.final =
-			  CG_RandomiseValue( bp->dLightRadius.final, bp->dLightRadius.finalRandFrac );
+	p->colorDelay = CG_RandomiseValue( bp->colorDelay, bp->colorDelayRandFrac );
 
-			p->colorDelay = CG_RandomiseValue( bp->colorDelay, bp->colorDelayRandFrac );
+	p->bounceMarkRadius = CG_RandomiseValue( bp->bounceMarkRadius, bp->bounceMarkRadiusRandFrac );
+	p->bounceMarkCount =
+	  rint( CG_RandomiseValue( ( float ) bp->bounceMarkCount, bp->bounceMarkCountRandFrac ) );
+	p->bounceSoundCount =
+	  rint( CG_RandomiseValue( ( float ) bp->bounceSoundCount, bp->bounceSoundCountRandFrac ) );
 
-			p->bounceMarkRadius = CG_RandomiseValue( bp->bounceMarkRadius, bp->bounceMarkRadiusRandFrac );
-			p->bounceMarkCount =
-			  rint( CG_RandomiseValue( ( float ) bp->bounceMarkCount, bp->bounceMarkCountRandFrac ) );
-			p->bounceSoundCount =
-			  rint( CG_RandomiseValue( ( float ) bp->bounceSoundCount, bp->bounceSoundCountRandFrac ) );
+	if ( bp->numModels )
+	{
+		p->model = bp->models[ rand() % bp->numModels ];
 
-			if ( bp->numModels )
-			{
-				p->model = bp->models[ rand() % bp->numModels ];
+		if ( bp->modelAnimation.frameLerp < 0 )
+		{
+			bp->modelAnimation.frameLerp = p->lifeTime / bp->modelAnimation.numFrames;
+			bp->modelAnimation.initialLerp = p->lifeTime / bp->modelAnimation.numFrames;
+		}
+		else if ( bp->modelAnimation.frameLerp == 0 )
+		{
+			// Bypass calculations in CG_RunLerpFrame if there is no modelAnimation
+			// since it will try to divide by frameLerp
+			p->lf.animationTime = std::numeric_limits<int>::max();
+		}
+	}
 
-				if ( bp->modelAnimation.frameLerp < 0 )
-				{
-					bp->modelAnimation.frameLerp = p->lifeTime / bp->modelAnimation.numFrames;
-					bp->modelAnimation.initialLerp = p->lifeTime / bp->modelAnimation.numFrames;
-				}
-				else if ( bp->modelAnimation.frameLerp == 0 )
-				{
-					// Bypass calculations in CG_RunLerpFrame if there is no modelAnimation
-					// since it will try to divide by frameLerp
-					p->lf.animationTime = std::numeric_limits<int>::max();
-				}
-			}
+	vec3_t attachmentPoint;
+	if ( !CG_AttachmentPoint( &ps->attachment, attachmentPoint ) )
+	{
+		CG_ReleaseParticle( p );
+		return nullptr;
+	}
 
-			vec3_t attachmentPoint;
-			if ( !CG_AttachmentPoint( &ps->attachment, attachmentPoint ) )
-			{
-				return nullptr;
-			}
+	VectorCopy( attachmentPoint, p->origin );
+
+	vec3_t transform[ 3 ];
+	if ( CG_AttachmentAxis( &ps->attachment, transform ) )
+	{
+		vec3_t transDisplacement;
 
-			VectorCopy( attachmentPoint, p->origin );
+		VectorMatrixMultiply( bp->displacement, transform, transDisplacement );
+		VectorAdd( p->origin, transDisplacement, p->origin );
+	}
+	else
+	{
+		VectorAdd( p->origin, bp->displacement, p->origin );
+	}
 
-			vec3_t transform[ 3 ];
-			if ( CG_AttachmentAxis( &ps->attachment, transform ) )
-			{
-				vec3_t transDisplacement;
+	p->origin[ 0 ] += ( crandom() * bp->randDisplacement[ 0 ] );
+	p->origin[ 1 ] += ( crandom() * bp->randDisplacement[ 1 ] );
+	p->origin[ 2 ] += ( crandom() * bp->randDisplacement[ 2 ] );
 
-				VectorMatrixMultiply( bp->displacement, transform, transDisplacement );
-				VectorAdd( p->origin, transDisplacement, p->origin );
+	switch ( bp->velMoveType )
+	{
+		case PMT_STATIC:
+			if ( bp->velMoveValues.dirType == PMD_POINT )
+			{
+				VectorSubtract( bp->velMoveValues.point, p->origin, p->velocity );
 			}
-			else
+			else if ( bp->velMoveValues.dirType == PMD_LINEAR )
 			{
-				VectorAdd( p->origin, bp->displacement, p->origin );
+				VectorCopy( bp->velMoveValues.dir, p->velocity );
 			}
 
-			p->origin[ 0 ] += ( crandom() * bp->randDisplacement[ 0 ] );
-			p->origin[ 1 ] += ( crandom() * bp->randDisplacement[ 1 ] );
-			p->origin[ 2 ] += ( crandom() * bp->randDisplacement[ 2 ] );
+			break;
 
-			switch ( bp->velMoveType )
+		case PMT_STATIC_TRANSFORM:
+			if ( !CG_AttachmentAxis( &ps->attachment, transform ) )
 			{
-				case PMT_STATIC:
-					if ( bp->velMoveValues.dirType == PMD_POINT )
-					{
-						VectorSubtract( bp->velMoveValues.point, p->origin, p->velocity );
-					}
-					else if ( bp->velMoveValues.dirType == PMD_LINEAR )
-					{
-						VectorCopy( bp->velMoveValues.dir, p->velocity );
-					}
-
-					break;
-
-				case PMT_STATIC_TRANSFORM:
-					if ( !CG_AttachmentAxis( &ps->attachment, transform ) )
-					{
-						return nullptr;
-					}
-
-					if ( bp->velMoveValues.dirType == PMD_POINT )
-					{
-						vec3_t transPoint;
-
-						VectorMatrixMultiply( bp->velMoveValues.point, transform, transPoint );
-						VectorSubtract( transPoint, p->origin, p->velocity );
-					}
-					else if ( bp->velMoveValues.dirType == PMD_LINEAR )
-					{
-						VectorMatrixMultiply( bp->velMoveValues.dir, transform, p->velocity );
-					}
+				CG_ReleaseParticle( p );
+				return nullptr;
+			}
 
-					break;
+			if ( bp->velMoveValues.dirType == PMD_POINT )
+			{
+				vec3_t transPoint;
 
-				case PMT_TAG:
-				case PMT_CENT_ANGLES:
-					if ( bp->velMoveValues.dirType == PMD_POINT )
-					{
-						VectorSubtract( attachmentPoint, p->origin, p->velocity );
-					}
-					else if ( bp->velMoveValues.dirType == PMD_LINEAR )
-					{
-						if ( !CG_AttachmentDir( &ps->attachment, p->velocity ) )
-						{
-							return nullptr;
-						}
-					}
+				VectorMatrixMultiply( bp->velMoveValues.point, transform, transPoint );
+				VectorSubtract( transPoint, p->origin, p->velocity );
+			}
+			else if ( bp->velMoveValues.dirType == PMD_LINEAR )
+			{
+				VectorMatrixMultiply( bp->velMoveValues.dir, transform, p->velocity );
+			}
 
-					break;
+			break;
 
-				case PMT_NORMAL:
-					if ( !ps->normalValid )
-					{
-						logger.Warn("a particle with velocityType "
-						           "normal has no normal" );
-						return nullptr;
-					}
+		case PMT_TAG:
+		case PMT_CENT_ANGLES:
+			if ( bp->velMoveValues.dirType == PMD_POINT )
+			{
+				VectorSubtract( attachmentPoint, p->origin, p->velocity );
+			}
+			else if ( bp->velMoveValues.dirType == PMD_LINEAR )
+			{
+				if ( !CG_AttachmentDir( &ps->attachment, p->velocity ) )
+				{
+					CG_ReleaseParticle( p );
+					return nullptr;
+				}
+			}
 
-					VectorCopy( ps->normal, p->velocity );
+			break;
 
-					//normal displacement
-					VectorNormalize( p->velocity );
-					VectorMA( p->origin, bp->normalDisplacement, p->velocity, p->origin );
-					break;
+		case PMT_NORMAL:
+			if ( !ps->normalValid )
+			{
+				logger.Warn("a particle with velocityType "
+				           "normal has no normal" );
+				CG_ReleaseParticle( p );
+				return nullptr;
+			}
 
-				case PMT_LAST_NORMAL:
-					VectorCopy( ps->lastNormal, p->velocity );
-					VectorNormalize( p->velocity );
-					VectorMA( p->origin, bp->normalDisplacement, p->velocity, p->origin );
-					break;
+			VectorCopy( ps->normal, p->velocity );
 
-				case PMT_OPPORTUNISTIC_NORMAL:
-					if ( ps->lastNormalIsCurrent )
-					{
-						VectorCopy( ps->lastNormal, p->velocity );
-						VectorNormalize( p->velocity );
-						VectorMA( p->origin, bp->normalDisplacement, p->velocity, p->origin );
-					}
-					break;
-			}
+			//normal displacement
+			VectorNormalize( p->velocity );
+			VectorMA( p->origin, bp->normalDisplacement, p->velocity, p->origin );
+			break;
 
+		case PMT_LAST_NORMAL:
+			VectorCopy( ps->lastNormal, p->velocity );
 			VectorNormalize( p->velocity );
-			CG_SpreadVector( p->velocity, bp->velMoveValues.dirRandAngle );
-			VectorScale( p->velocity,
-			             CG_RandomiseValue( bp->velMoveValues.mag, bp->velMoveValues.magRandFrac ),
-			             p->velocity );
+			VectorMA( p->origin, bp->normalDisplacement, p->velocity, p->origin );
+			break;
 
-			vec3_t attachmentVelocity;
-			if ( CG_AttachmentVelocity( &ps->attachment, attachmentVelocity ) )
+		case PMT_OPPORTUNISTIC_NORMAL:
+			if ( ps->lastNormalIsCurrent )
 			{
-				VectorMA( p->velocity,
-				          CG_RandomiseValue( bp->velMoveValues.parentVelFrac,
-				                             bp->velMoveValues.parentVelFracRandFrac ), attachmentVelocity, p->velocity );
+				VectorCopy( ps->lastNormal, p->velocity );
+				VectorNormalize( p->velocity );
+				VectorMA( p->origin, bp->normalDisplacement, p->velocity, p->origin );
 			}
+			break;
+	}
 
-			p->lastEvalTime = cg.time;
+	VectorNormalize( p->velocity );
+	CG_SpreadVector( p->velocity, bp->velMoveValues.dirRandAngle );
+	VectorScale( p->velocity,
+	             CG_RandomiseValue( bp->velMoveValues.mag, bp->velMoveValues.magRandFrac ),
+	             p->velocity );
 
-			p->valid = true;
+	vec3_t attachmentVelocity;
+	if ( CG_AttachmentVelocity( &ps->attachment, attachmentVelocity ) )
+	{
+		VectorMA( p->velocity,
+		          CG_RandomiseValue( bp->velMoveValues.parentVelFrac,
+		                             bp->velMoveValues.parentVelFracRandFrac ), attachmentVelocity, p->velocity );
+	}
 
-			//this particle has a child particle system attached
-			if ( bp->childSystemName[ 0 ] != '\0' )
-			{
-				particleSystem_t *chps = CG_SpawnNewParticleSystem( bp->childSystemHandle );
+	p->lastEvalTime = cg.time;
 
-				if ( CG_IsParticleSystemValid( &chps ) )
-				{
-					CG_SetAttachmentParticle( &chps->attachment, p );
-					CG_AttachToParticle( &chps->attachment );
-					p->childParticleSystem = chps;
-
-					if ( ps->lastNormalIsCurrent )
-						CG_SetParticleSystemLastNormal( chps, ps->lastNormal );
-					else
-						VectorCopy( ps->lastNormal, chps->lastNormal );
-				}
-			}
+	p->valid = true;
+	pe->numLiveParticles++;
+	CG_AddParticleToStore( p );
 
-			//this particle has a child trail system attached
-			if ( bp->childTrailSystemName[ 0 ] != '\0' )
-			{
-				trailSystem_t *ts = CG_SpawnNewTrailSystem( bp->childTrailSystemHandle );
+	p->sortIndex = numSortedParticles;
+	sortedParticles[ numSortedParticles++ ] = p;
 
-				if ( ts != nullptr )
-				{
-					CG_SetAttachmentParticle( &ts->frontAttachment, p );
-					CG_AttachToParticle( &ts->frontAttachment );
-				}
-			}
+	//this particle has a child particle system attached
+	if ( bp->childSystemName[ 0 ] != '\0' )
+	{
+		particleSystem_t *chps = CG_SpawnNewParticleSystem( bp->childSystemHandle );
+
+		if ( CG_IsParticleSystemValid( &chps ) )
+		{
+			CG_SetAttachmentParticle( &chps->attachment, p );
+			CG_AttachToParticle( &chps->attachment );
+			p->childParticleSystem = chps;
 
-			return p;
+			if ( ps->lastNormalIsCurrent )
+				CG_SetParticleSystemLastNormal( chps, ps->lastNormal );
+			else
+				VectorCopy( ps->lastNormal, chps->lastNormal );
 		}
 	}
 
-	logger.Notice( "MAX_PARTICLES hit" );
-	return nullptr;
+	//this particle has a child trail system attached
+	if ( bp->childTrailSystemName[ 0 ] != '\0' )
+	{
+		trailSystem_t *ts = CG_SpawnNewTrailSystem( bp->childTrailSystemHandle );
+
+		if ( ts != nullptr )
+		{
+			CG_SetAttachmentParticle( &ts->frontAttachment, p );
+			CG_AttachToParticle( &ts->frontAttachment );
+		}
+	}
+
+	return p;
 }
 
 /*
@@ -423,25 +643,10 @@ static void CG_SpawnNewParticles()
 				}
 			}
 
-			if ( pe->count == 0 || ps->lazyRemove )
+			//wait for child particles to die before declaring this pe invalid
+			if ( ( pe->count == 0 || ps->lazyRemove ) && !pe->numLiveParticles )
 			{
-				int count = 0;
-
-				//wait for child particles to die before declaring this pe invalid
-				for ( int j = 0; j < MAX_PARTICLES; j++ )
-				{
-					particle_t *p = &particles[ j ];
-
-					if ( p->valid && p->parent == pe )
-					{
-						count++;
-					}
-				}
-
-				if ( !count )
-				{
-					pe->valid = false;
-				}
+				pe->valid = false;
 			}
 		}
 	}
@@ -1209,6 +1414,10 @@ static bool CG_ParseParticle( baseParticle_t *bp, const char **text_p )
 		{
 			bp->realLight = true;
 		}
+		else if ( !Q_stricmp( token, "noBatching" ) )
+		{
+			bp->noBatching = true;
+		}
 		else if ( !Q_stricmp( token, "dynamicLight" ) )
 		{
 			bp->dynamicLight = true;
@@ -1813,6 +2022,8 @@ Load particle systems from .particle files
 */
 void CG_LoadParticleSystems()
 {
+	CG_InitParticlePool();
+
 	//clear out the old
 	numBaseParticleSystems = 0;
 	numBaseParticleEjectors = 0;
@@ -2114,30 +2325,27 @@ static void CG_GarbageCollectParticleSystems()
 
 /*
 ===============
-CG_CalculateTimeFrac
+CG_PrepareParticlePhysics
 
-Calculate the fraction of time passed
+Compute the acceleration of a specific particle and
+hand it to the kernel together with its state
 ===============
 */
-static float CG_CalculateTimeFrac( int birth, int life, int delay )
+static void CG_PrepareParticlePhysics( particle_t *p )
 {
-	float frac = ( ( float ) cg.time - ( float )( birth + delay ) ) / ( float )( life - delay );
+	int index = p->storeIndex;
 
-	return Math::Clamp( frac, 0.0f, 1.0f );
-}
+	//keep the kernel input clean for particles that don't move
+	particleStore.stepped[ index ] = false;
+	particleStore.deltaTime[ index ] = 0.0f;
 
-/*
-===============
-CG_EvaluateParticlePhysics
+	for ( int axis = 0; axis < 3; axis++ )
+	{
+		particleStore.acceleration[ axis ][ index ] = 0.0f;
+	}
 
-Compute the physics on a specific particle
-===============
-*/
-static void CG_EvaluateParticlePhysics( particle_t *p )
-{
 	if ( p->atRest )
 	{
-		VectorClear( p->velocity );
 		return;
 	}
 
@@ -2254,30 +2462,219 @@ static void CG_EvaluateParticlePhysics( particle_t *p )
 		             acceleration );
 	}
 
-	// Some particles have a visual radius that differs from their collision radius
-	float radius;
-	if ( bp->physicsRadius )
+	float deltaTime = ( float )( cg.time - p->lastEvalTime ) * 0.001;
+
+	particleStore.stepped[ index ] = true;
+	particleStore.deltaTime[ index ] = deltaTime;
+
+	for ( int axis = 0; axis < 3; axis++ )
 	{
-		radius = bp->physicsRadius;
+		particleStore.origin[ axis ][ index ] = p->origin[ axis ];
+		particleStore.velocity[ axis ][ index ] = p->velocity[ axis ];
+		particleStore.acceleration[ axis ][ index ] = acceleration[ axis ];
 	}
-	else
+}
+
+/*
+===============
+CG_RunParticleKernels
+
+Integrate the motion and evaluate the lerp values
+of all live particles in one pass
+===============
+*/
+static void CG_RunParticleKernels()
+{
+	const float *const origin[ 3 ] =
+	{
+		particleStore.origin[ 0 ], particleStore.origin[ 1 ], particleStore.origin[ 2 ]
+	};
+	float *const velocity[ 3 ] =
+	{
+		particleStore.velocity[ 0 ], particleStore.velocity[ 1 ], particleStore.velocity[ 2 ]
+	};
+	const float *const acceleration[ 3 ] =
+	{
+		particleStore.acceleration[ 0 ], particleStore.acceleration[ 1 ], particleStore.acceleration[ 2 ]
+	};
+	float *const newOrigin[ 3 ] =
+	{
+		particleStore.newOrigin[ 0 ], particleStore.newOrigin[ 1 ], particleStore.newOrigin[ 2 ]
+	};
+
+	CG_IntegrateParticles( particleStore.count, origin, velocity, acceleration,
+	                       particleStore.deltaTime, newOrigin );
+
+	for ( int curve = 0; curve < PC_NUM; curve++ )
+	{
+		CG_EvaluateParticleCurves( particleStore.count, ( float ) cg.time,
+		                           particleStore.curveStart[ curve ], particleStore.curveDuration[ curve ],
+		                           particleStore.curveInitial[ curve ], particleStore.curveFinal[ curve ],
+		                           particleStore.curveValue[ curve ] );
+	}
+}
+
+/*
+===============
+CG_ClipToCachedPlane
+
+Clip the motion of a particle's bounding box against the
+surface its last trace hit, if it started in front of it
+===============
+*/
+static bool CG_ClipToCachedPlane( particle_t *p, const vec3_t end, float radius, trace_t *trace )
+{
+	const float *normal = p->collisionNormal;
+
+	//distance of the box corner closest to the plane
+	float offset = radius * ( fabsf( normal[ 0 ] ) + fabsf( normal[ 1 ] ) + fabsf( normal[ 2 ] ) );
+	float startDist = DotProduct( p->origin, normal ) - p->collisionDist - offset;
+	float endDist = DotProduct( end, normal ) - p->collisionDist - offset;
+
+	if ( startDist < 0.0f )
+	{
+		return false;
+	}
+
+	*trace = {};
+
+	if ( endDist >= 0.0f )
+	{
+		trace->fraction = 1.0f;
+		VectorCopy( end, trace->endpos );
+		return true;
+	}
+
+	trace->fraction = startDist / ( startDist - endDist );
+	VectorLerpTrem( trace->fraction, p->origin, end, trace->endpos );
+	VectorCopy( normal, trace->plane.normal );
+	trace->plane.dist = p->collisionDist;
+
+	return true;
+}
+
+/*
+===============
+CG_TraceParticle
+
+Trace the motion of a particle, reusing its last hit surface while
+it stays close to it. Returns false if the particle should wait
+for a later frame, either because it is far away or because the
+trace budget for this frame is spent.
+===============
+*/
+static bool CG_TraceParticle( particle_t *p, const vec3_t end, float radius, trace_t *trace )
+{
+	float tolerance = cg_particleTraceTolerance.Get();
+
+	if ( p->collisionPlaneValid &&
+	     DistanceSquared( p->collisionOrigin, end ) < tolerance * tolerance &&
+	     CG_ClipToCachedPlane( p, end, radius, trace ) )
 	{
-		radius = CG_LerpValues( p->radius.initial, p->radius.final,
-		                        CG_CalculateTimeFrac( p->birthTime, p->lifeTime,
-		                            p->radius.delay ) );
+		return true;
 	}
 
+	float farDistance = cg_particleFarCollisionDistance.Get();
+
+	if ( cg.time - p->lastEvalTime < PARTICLE_FAR_COLLISION_PERIOD &&
+	     DistanceSquared( p->origin, cg.refdef.vieworg ) > farDistance * farDistance )
+	{
+		return false;
+	}
+
+	int budget = cg_particleTraceBudget.Get();
+
+	if ( budget && numParticleTraces >= budget )
+	{
+		return false;
+	}
+
+	numParticleTraces++;
+
+	particleSystem_t *ps = p->parent->parent;
 	vec3_t mins, maxs;
 	VectorSet( mins, -radius, -radius, -radius );
 	VectorSet( maxs, radius, radius, radius );
 
-	float bounce = CG_RandomiseValue( bp->bounceFrac, bp->bounceFracRandFrac );
+	CG_Trace( trace, p->origin, mins, maxs, end, CG_AttachmentCentNum( &ps->attachment ),
+	          CONTENTS_SOLID, 0 );
 
-	float deltaTime = ( float )( cg.time - p->lastEvalTime ) * 0.001;
-	VectorMA( p->velocity, deltaTime, acceleration, p->velocity );
+	if ( trace->fraction < 1.0f && !trace->startsolid )
+	{
+		p->collisionPlaneValid = true;
+		VectorCopy( trace->plane.normal, p->collisionNormal );
+		p->collisionDist = trace->plane.dist;
+		VectorCopy( trace->endpos, p->collisionOrigin );
+	}
+
+	return true;
+}
+
+/*
+===============
+CG_EvaluateParticlePhysics
+
+Apply the motion computed by the kernel to a specific
+particle and handle its collisions
+===============
+*/
+static void CG_EvaluateParticlePhysics( particle_t *p )
+{
+	if ( p->atRest )
+	{
+		VectorClear( p->velocity );
+		return;
+	}
+
+	int index = p->storeIndex;
+
+	if ( !particleStore.stepped[ index ] )
+	{
+		return;
+	}
+
+	//only apply the step once
+	particleStore.stepped[ index ] = false;
+
+	baseParticle_t *bp = p->class_;
 
 	vec3_t newOrigin;
-	VectorMA( p->origin, deltaTime, p->velocity, newOrigin );
+	for ( int axis = 0; axis < 3; axis++ )
+	{
+		newOrigin[ axis ] = particleStore.newOrigin[ axis ][ index ];
+	}
+
+	//particles that never bounce don't need a trace
+	bool collides = cg_bounceParticles.Get() &&
+	                !( bp->bounceFrac == 0.0f && bp->bounceFracRandFrac == 0.0f );
+
+	trace_t trace;
+
+	if ( collides )
+	{
+		// Some particles have a visual radius that differs from their collision radius
+		float radius;
+		if ( bp->physicsRadius )
+		{
+			radius = bp->physicsRadius;
+		}
+		else
+		{
+			radius = particleStore.curveValue[ PC_RADIUS ][ index ];
+		}
+
+		//leave the particle where it is, it will make a longer step once it gets its trace
+		if ( !CG_TraceParticle( p, newOrigin, radius, &trace ) )
+		{
+			return;
+		}
+	}
+
+	for ( int axis = 0; axis < 3; axis++ )
+	{
+		p->velocity[ axis ] = particleStore.velocity[ axis ][ index ];
+	}
+
 	p->lastEvalTime = cg.time;
 
 	// we're not doing particle physics, but at least cull them in solids
@@ -2297,12 +2694,10 @@ static void CG_EvaluateParticlePhysics( particle_t *p )
 		return;
 	}
 
-	trace_t trace;
-	CG_Trace( &trace, p->origin, mins, maxs, newOrigin, CG_AttachmentCentNum( &ps->attachment ),
-	          CONTENTS_SOLID, 0 );
+	float bounce = collides ? CG_RandomiseValue( bp->bounceFrac, bp->bounceFracRandFrac ) : 0.0f;
 
 	//not hit anything or not a collider
-	if ( trace.fraction == 1.0f || bounce == 0.0f )
+	if ( !collides || trace.fraction == 1.0f || bounce == 0.0f )
 	{
 		VectorCopy( newOrigin, p->origin );
 		if ( CG_IsParticleSystemValid( &p->childParticleSystem ) )
@@ -2358,89 +2753,32 @@ static void CG_EvaluateParticlePhysics( particle_t *p )
 	}
 }
 
-#define GETKEY(x,y) ((( x ) >> (y) ) & 0xFF )
-
-/*
-===============
-CG_Radix
-===============
-*/
-static void CG_Radix( int bits, int size, particle_t **source, particle_t **dest )
-{
-	int count[ 256 ];
-	memset( count, 0, sizeof( count ) );
-
-	for ( int i = 0; i < size; i++ )
-	{
-		count[ GETKEY( source[ i ]->sortKey, bits ) ]++;
-	}
-
-	int index[ 256 ];
-	index[ 0 ] = 0;
-
-	for ( int i = 1; i < 256; i++ )
-	{
-		index[ i ] = index[ i - 1 ] + count[ i - 1 ];
-	}
-
-	for ( int i = 0; i < size; i++ )
-	{
-		dest[ index[ GETKEY( source[ i ]->sortKey, bits ) ]++ ] = source[ i ];
-	}
-}
-
 /*
 ===============
-CG_RadixSort
-
-Radix sort with 4 byte size buckets
-===============
-*/
-static void CG_RadixSort( particle_t **source, particle_t **temp, int size )
-{
-	CG_Radix( 0,   size, source, temp );
-	CG_Radix( 8,   size, temp, source );
-	CG_Radix( 16,  size, source, temp );
-	CG_Radix( 24,  size, temp, source );
-}
+CG_SortParticles
 
-/*
-===============
-CG_CompactAndSortParticles
+Depth sort the particles, back to front
 
-Depth sort the particles
+The order barely changes from one frame to the next, so an
+insertion sort of last frame's order is close to linear. When it
+isn't, e.g. after a teleport or a burst of far away particles, the
+insertion sort gives up and the whole list is sorted instead.
 ===============
 */
-static void CG_CompactAndSortParticles()
+static void CG_SortParticles()
 {
-	for ( int i = 0; i < MAX_PARTICLES; i++ )
-	{
-		sortedParticles[ i ] = &particles[ i ];
-	}
+	//drop the particles that died since the last sort
+	int numParticles = 0;
 
-	int n = 0;
-	for ( n = MAX_PARTICLES - 1; n >= 0; n-- )
+	for ( int i = 0; i < numSortedParticles; i++ )
 	{
-		int i = 0;
-		if ( sortedParticles[ n ]->valid )
+		if ( sortedParticles[ i ] )
 		{
-			//find the first hole
-			while ( i < MAX_PARTICLES && sortedParticles[ i ]->valid )
-			{
-				i++;
-			}
-
-			//no more holes
-			if ( i >= n )
-			{
-				break;
-			}
-
-			sortedParticles[ i ] = sortedParticles[ n ];
+			sortedParticles[ numParticles++ ] = sortedParticles[ i ];
 		}
 	}
 
-	int numParticles = n;
+	numSortedParticles = numParticles;
 
 	//set sort keys
 	for ( int i = 0; i < numParticles; i++ )
@@ -2450,18 +2788,34 @@ static void CG_CompactAndSortParticles()
 		sortedParticles[ i ]->sortKey = ( int ) DotProduct( delta, delta );
 	}
 
-	CG_RadixSort( sortedParticles, radixBuffer, numParticles );
+	//every pass of the inner loop moves a particle one place
+	int shiftBudget = 8 * numParticles;
 
-	//FIXME: wtf?
-	//reverse order of particles array
-	for ( int i = 0; i < numParticles; i++ )
+	for ( int i = 1; i < numParticles; i++ )
 	{
-		radixBuffer[ i ] = sortedParticles[ numParticles - i - 1 ];
+		particle_t *p = sortedParticles[ i ];
+		int j = i;
+
+		while ( j > 0 && sortedParticles[ j - 1 ]->sortKey < p->sortKey )
+		{
+			sortedParticles[ j ] = sortedParticles[ j - 1 ];
+			j--;
+		}
+
+		sortedParticles[ j ] = p;
+		shiftBudget -= i - j;
+
+		if ( shiftBudget < 0 )
+		{
+			std::sort( sortedParticles, sortedParticles + numParticles,
+			           []( const particle_t *a, const particle_t *b ) { return a->sortKey > b->sortKey; } );
+			break;
+		}
 	}
 
 	for ( int i = 0; i < numParticles; i++ )
 	{
-		sortedParticles[ i ] = radixBuffer[ i ];
+		sortedParticles[ i ]->sortIndex = i;
 	}
 }
 
@@ -2474,13 +2828,10 @@ Actually render a particle
 */
 static void CG_RenderParticle( particle_t *p )
 {
-	float timeFrac = CG_CalculateTimeFrac( p->birthTime, p->lifeTime, 0 );
+	int index = p->storeIndex;
 
-	float scale = CG_LerpValues( p->radius.initial,
-	                       p->radius.final,
-	                       CG_CalculateTimeFrac( p->birthTime,
-	                           p->lifeTime,
-	                           p->radius.delay ) );
+	float timeFrac = particleStore.curveValue[ PC_LIFE ][ index ];
+	float scale = particleStore.curveValue[ PC_RADIUS ][ index ];
 
 	refEntity_t re{};
 	re.shaderTime = float(double(p->birthTime) * 0.001);
@@ -2509,26 +2860,15 @@ static void CG_RenderParticle( particle_t *p )
 			                bp->initialColor, colorRange );
 
 			VectorMA( bp->initialColor,
-			          CG_CalculateTimeFrac( p->birthTime,
-			                                p->lifeTime,
-			                                p->colorDelay ),
+			          particleStore.curveValue[ PC_COLOR ][ index ],
 			          colorRange, re.shaderRGBA.ToArray() );
 		}
 
-		re.shaderRGBA.SetAlpha( ( float ) 0xFF *
-		                               CG_LerpValues( p->alpha.initial,
-		                                   p->alpha.final,
-		                                   CG_CalculateTimeFrac( p->birthTime,
-		                                       p->lifeTime,
-		                                       p->alpha.delay ) ) );
+		re.shaderRGBA.SetAlpha( ( float ) 0xFF * particleStore.curveValue[ PC_ALPHA ][ index ] );
 
 		re.radius = scale;
 
-		re.rotation = CG_LerpValues( p->rotation.initial,
-		                             p->rotation.final,
-		                             CG_CalculateTimeFrac( p->birthTime,
-		                                 p->lifeTime,
-		                                 p->rotation.delay ) );
+		re.rotation = particleStore.curveValue[ PC_ROTATION ][ index ];
 
 		// if the view would be "inside" the sprite, kill the sprite
 		// so it doesn't add too much overdraw
@@ -2537,24 +2877,24 @@ static void CG_RenderParticle( particle_t *p )
 			return;
 		}
 
-		int index;
+		int frame;
 		if ( bp->framerate == 0.0f )
 		{
 			//sync animation time to lifeTime of particle
-			index = ( int )( timeFrac * ( bp->numFrames + 1 ) );
+			frame = ( int )( timeFrac * ( bp->numFrames + 1 ) );
 
-			if ( index >= bp->numFrames )
+			if ( frame >= bp->numFrames )
 			{
-				index = bp->numFrames - 1;
+				frame = bp->numFrames - 1;
 			}
 
-			re.customShader = bp->shaders[ index ];
+			re.customShader = bp->shaders[ frame ];
 		}
 		else
 		{
 			//looping animation
-			index = ( int )( bp->framerate * timeFrac * p->lifeTime * 0.001 ) % bp->numFrames;
-			re.customShader = bp->shaders[ index ];
+			frame = ( int )( bp->framerate * timeFrac * p->lifeTime * 0.001 ) % bp->numFrames;
+			re.customShader = bp->shaders[ frame ];
 		}
 	}
 	else if ( bp->numModels ) //model based
@@ -2622,8 +2962,7 @@ static void CG_RenderParticle( particle_t *p )
 	if ( bp->dynamicLight && !( re.renderfx & RF_THIRD_PERSON ) )
 	{
 		trap_R_AddLightToScene( p->origin,
-		                        CG_LerpValues( p->dLightRadius.initial, p->dLightRadius.final,
-		                            CG_CalculateTimeFrac( p->birthTime, p->lifeTime, p->dLightRadius.delay ) ),
+		                        particleStore.curveValue[ PC_DLIGHT_RADIUS ][ index ],
 		                        3,
 		                        ( float ) bp->dLightColor[ 0 ] / ( float ) 0xFF,
 		                        ( float ) bp->dLightColor[ 1 ] / ( float ) 0xFF,
@@ -2632,6 +2971,17 @@ static void CG_RenderParticle( particle_t *p )
 
 	VectorCopy( p->origin, re.origin );
 
+	// sprites are batched into polys, unless:
+	// - the class asks for its shaders to animate from the particle's birth, polys have no shaderTime
+	// - the renderer must hide it from the first person view, it only can for refEntities
+	// - a portal or mirror may render it, polys are oriented for the main view only
+	if ( re.reType == refEntityType_t::RT_SPRITE && !bp->noBatching &&
+	     !( re.renderfx & RF_THIRD_PERSON ) && CG_EntitiesOfType( entityType_t::ET_PORTAL ).empty() &&
+	     CG_BatchSprite( re.customShader, re.origin, re.radius, re.rotation, re.shaderRGBA.ToArray() ) )
+	{
+		return;
+	}
+
 	trap_R_AddRefEntityToScene( &re );
 }
 
@@ -2650,28 +3000,71 @@ void CG_AddParticles()
 	//check each ejector and introduce any new particles
 	CG_SpawnNewParticles();
 
-	//sorting
-	CG_CompactAndSortParticles();
+	//remove expired particles and gather the input for the kernels,
+	//backwards since destroying moves the last particle into the hole
+	for ( int i = particleStore.count - 1; i >= 0; i-- )
+	{
+		particle_t *p = particleStore.owner[ i ];
 
-	for ( int i = 0; i < MAX_PARTICLES; i++ )
+		if ( p->birthTime + p->lifeTime > cg.time )
+		{
+			CG_PrepareParticlePhysics( p );
+		}
+		else
+		{
+			CG_DestroyParticle( p, nullptr );
+		}
+	}
+
+	CG_RunParticleKernels();
+
+	//run collisions, starting with the particles that were
+	//left without a trace in the last frame
+	int numPhysics = particleStore.count;
+	int firstDeferred = -1;
+
+	if ( physicsCursor >= numPhysics )
 	{
-		particle_t *p = sortedParticles[ i ];
+		physicsCursor = 0;
+	}
+
+	for ( int i = 0; i < numPhysics; i++ )
+	{
+		physicsOrder[ i ] = particleStore.owner[ ( physicsCursor + i ) % numPhysics ];
+	}
+
+	numParticleTraces = 0;
+
+	for ( int i = 0; i < numPhysics; i++ )
+	{
+		particle_t *p = physicsOrder[ i ];
+
+		if ( firstDeferred < 0 && cg_particleTraceBudget.Get() &&
+		     numParticleTraces >= cg_particleTraceBudget.Get() )
+		{
+			firstDeferred = i;
+		}
 
+		//may have been destroyed by an earlier collision
 		if ( p->valid )
 		{
-			if ( p->birthTime + p->lifeTime > cg.time )
-			{
-				//particle is active
-				CG_EvaluateParticlePhysics( p );
-				CG_RenderParticle( p );
-			}
-			else
-			{
-				CG_DestroyParticle( p, nullptr );
-			}
+			CG_EvaluateParticlePhysics( p );
 		}
 	}
 
+	if ( firstDeferred >= 0 && particleStore.count )
+	{
+		physicsCursor = ( physicsCursor + firstDeferred ) % particleStore.count;
+	}
+
+	//sorting
+	CG_SortParticles();
+
+	for ( int i = 0; i < numSortedParticles; i++ )
+	{
+		CG_RenderParticle( sortedParticles[ i ] );
+	}
+
 	if ( cg_debugParticles.Get() >= 2 )
 	{
 		int numPS = 0, numPE = 0, numP = 0;
@@ -2700,7 +3093,7 @@ void CG_AddParticles()
 			}
 		}
 
-		logger.Debug( "PS: %d  PE: %d  P: %d", numPS, numPE, numP );
+		logger.Debug( "PS: %d  PE: %d  P: %d  traces: %d", numPS, numPE, numP, numParticleTraces );
 	}
 }
 
@@ -2795,3 +3188,36 @@ void CG_TestPS_f()
 		}
 	}
 }
+
+/*
+===============
+TestParticleKernelsCmd
+
+Check the SIMD particle kernels against their scalar versions
+===============
+*/
+class TestParticleKernelsCmd : public Cmd::StaticCmd
+{
+public:
+	TestParticleKernelsCmd() : StaticCmd( "testParticleKernels", Cmd::CGAME_VM | Cmd::CHEAT,
+	                                      "compare the SIMD particle kernels with their scalar versions" ) { }
+
+	void Run( const Cmd::Args &args ) const override
+	{
+		int      maxCount = args.Argc() > 1 ? std::max( 1, atoi( args.Argv( 1 ).c_str() ) ) : MAX_PARTICLES;
+		unsigned seed = args.Argc() > 2 ? strtoul( args.Argv( 2 ).c_str(), nullptr, 0 ) : 1;
+
+		if ( !CG_ParticleKernelsUseSSE2() )
+		{
+			Print( "the particle kernels were built without SSE2, there is nothing to compare" );
+			return;
+		}
+
+		float maxError = CG_TestParticleKernels( maxCount, seed );
+
+		Print( "%s: largest relative difference over lengths 1 to %d is %g",
+		       maxError <= 1e-6f ? "passed" : "FAILED", maxCount, maxError );
+	}
+};
+
+static TestParticleKernelsCmd testParticleKernelsCmdRegistration;
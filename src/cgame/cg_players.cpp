@@ -1529,6 +1529,16 @@ void CG_NewClientInfo( int clientNum )
 
 	CG_StatusMessages( &newInfo, ci );
 
+	// team overlay info is only sent when it changes, so keep it while the player stays in the team
+	if ( ci->infoValid && ci->team == newInfo.team )
+	{
+		newInfo.location       = ci->location;
+		newInfo.health         = ci->health;
+		newInfo.upgrade        = ci->upgrade;
+		newInfo.curWeaponClass = ci->curWeaponClass;
+		newInfo.credit         = ci->credit;
+	}
+
 	// replace whatever was there with the new one
 	newInfo.infoValid = true;
 	*ci = newInfo;
@@ -1600,7 +1610,7 @@ static void CG_SetLerpFrameAnimation( clientInfo_t *ci, lerpFrame_t *lf, int new
 
 		if ( lf->old_animation->handle && oldSkeleton.numBones == skel->numBones )
 		{
-			if ( !trap_R_BuildSkeleton( &oldSkeleton, lf->old_animation->handle, lf->oldFrame, lf->frame, lf->blendlerp, lf->old_animation->clearOrigin ) )
+			if ( !CG_BuildSkeleton( &oldSkeleton, lf->old_animation->handle, lf->oldFrame, lf->frame, lf->blendlerp, lf->old_animation->clearOrigin ) )
 			{
 				Log::Warn( "Can't blend skeleton" );
 				return;
@@ -1702,7 +1712,7 @@ static void CG_RunCorpseLerpFrame( clientInfo_t *ci, lerpFrame_t *lf, int newAni
 
 	if ( lf->animation )
 	{
-		if ( !trap_R_BuildSkeleton( &legsSkeleton, lf->animation->handle, anim->numFrames - 1, anim->numFrames - 1, 0, lf->animation->clearOrigin ) )
+		if ( !CG_BuildSkeleton( &legsSkeleton, lf->animation->handle, anim->numFrames - 1, anim->numFrames - 1, 0, lf->animation->clearOrigin ) )
 		{
 			Log::Warn( "Can't build lf->skeleton" );
 		}
@@ -1800,7 +1810,7 @@ static void CG_PlayerMD5AlienAnimation( centity_t *cent )
 	if ( blend.type == refSkeletonType_t::SK_RELATIVE )
 	{
 		CG_RunPlayerLerpFrame( ci, &cent->pe.legs, cent->pe.legs.animationNumber, &blend );
-		trap_R_BlendSkeleton( &legsSkeleton, &blend, 0.5 );
+		CG_BlendSkeleton( &legsSkeleton, &blend, 0.5 );
 	}
 }
 
@@ -2331,7 +2341,7 @@ static void CG_JetpackAnimation( centity_t *cent, int *old, int *now, float *bac
 
 				if ( lf->old_animation != nullptr && lf->old_animation->handle )
 				{
-					if ( !trap_R_BuildSkeleton( &oldSkeleton, lf->old_animation->handle, lf->oldFrame, lf->frame, lf->blendlerp, lf->old_animation->clearOrigin ) )
+					if ( !CG_BuildSkeleton( &oldSkeleton, lf->old_animation->handle, lf->oldFrame, lf->frame, lf->blendlerp, lf->old_animation->clearOrigin ) )
 					{
 						Log::Warn( "Can't build old jetpack skeleton" );
 						return;
@@ -3495,15 +3505,8 @@ centity_t *CG_GetLocation( vec3_t origin )
 	centity_t *best = nullptr;
 	bestlen = 3.0f * 8192.0f * 8192.0f;
 
-	for ( int num = MAX_CLIENTS; num <= cg_highestActiveEntity; num++ )
+	for ( centity_t *eloc : CG_EntitiesOfType( entityType_t::ET_LOCATION ) )
 	{
-		centity_t *eloc = &cg_entities[ num ];
-
-		if ( !eloc->valid || eloc->currentState.eType != entityType_t::ET_LOCATION )
-		{
-			continue;
-		}
-
 		len = DistanceSquared( origin, eloc->lerpOrigin );
 
 		if ( len > bestlen )
@@ -33,9 +33,84 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
 static  pmove_t   cg_pmove;
 
+// solid entities that can move or are brush models
 static BoundedVector<centity_t *, MAX_GENTITIES> cg_solidEntities;
 static BoundedVector<centity_t *, MAX_GENTITIES> cg_triggerEntities;
 
+// solid brush models, the only entities that CG_PointContents looks at
+static BoundedVector<centity_t *, MAX_GENTITIES> cg_solidBrushEntities;
+
+// solid boxes that stay in place until the next snapshot, sorted by mins[ 0 ]
+// so that traces only have to look at the boxes overlapping them along x
+struct solidBox_t
+{
+	vec3_t    mins, maxs;
+	centity_t *cent;
+};
+
+static BoundedVector<solidBox_t, MAX_GENTITIES> cg_staticSolids;
+static float cg_staticSolidsMaxWidth; // largest maxs[ 0 ] - mins[ 0 ] of the boxes
+
+/*
+====================
+CG_SolidEntityBox
+
+Bounding box of a solid entity that isn't a brush model
+====================
+*/
+static void CG_SolidEntityBox( const entityState_t *ent, const vec3_t origin, vec3_t mins, vec3_t maxs )
+{
+	if ( ent->eType == entityType_t::ET_BUILDABLE )
+	{
+		BG_BuildableBoundingBox( ent->modelindex, mins, maxs );
+	}
+	else
+	{
+		// encoded bbox
+		int x = ( ent->solid & 255 );
+		int zd = ( ( ent->solid >> 8 ) & 255 );
+		int zu = ( ( ent->solid >> 16 ) & 255 ) - 32;
+
+		mins[ 0 ] = mins[ 1 ] = -x;
+		maxs[ 0 ] = maxs[ 1 ] = x;
+		mins[ 2 ] = -zd;
+		maxs[ 2 ] = zu;
+	}
+
+	VectorAdd( origin, mins, mins );
+	VectorAdd( origin, maxs, maxs );
+}
+
+/*
+====================
+CG_IsStaticSolid
+
+Whether the solid box of an entity stays where it is until the next snapshot
+====================
+*/
+static bool CG_IsStaticSolid( const centity_t *cent )
+{
+	const entityState_t *cur = &cent->currentState;
+	const entityState_t *next = &cent->nextState;
+
+	if ( cur->solid == SOLID_BMODEL || cur->solid != next->solid || cur->modelindex != next->modelindex )
+	{
+		return false;
+	}
+
+	if ( cur->pos.trType != trType_t::TR_STATIONARY || next->pos.trType != trType_t::TR_STATIONARY ||
+	     !VectorCompare( cur->pos.trBase, next->pos.trBase ) )
+	{
+		return false;
+	}
+
+	// entities riding a mover are moved along with it
+	int ground = cur->groundEntityNum;
+
+	return ground <= 0 || ground >= ENTITYNUM_MAX_NORMAL ||
+	       cg_entities[ ground ].currentState.eType != entityType_t::ET_MOVER;
+}
+
 /*
 ====================
 CG_BuildSolidList
@@ -51,6 +126,9 @@ void CG_BuildSolidList()
 {
 	cg_solidEntities.clear();
 	cg_triggerEntities.clear();
+	cg_solidBrushEntities.clear();
+	cg_staticSolids.clear();
+	cg_staticSolidsMaxWidth = 0.0f;
 
 	snapshot_t *snap = (cg.nextSnap && !cg.nextFrameTeleport && !cg.thisFrameTeleport)
 		? cg.nextSnap
@@ -81,28 +159,119 @@ void CG_BuildSolidList()
 					break;
 			}
 
-			cg_solidEntities.append(cent);
+			if ( ent->solid == SOLID_BMODEL )
+			{
+				cg_solidBrushEntities.append(cent);
+			}
+
+			if ( CG_IsStaticSolid( cent ) )
+			{
+				solidBox_t box;
+
+				box.cent = cent;
+				CG_SolidEntityBox( ent, ent->pos.trBase, box.mins, box.maxs );
+				cg_staticSolidsMaxWidth = std::max( cg_staticSolidsMaxWidth, box.maxs[ 0 ] - box.mins[ 0 ] );
+				cg_staticSolids.append(box);
+			}
+			else
+			{
+				cg_solidEntities.append(cent);
+			}
 		}
 	}
+
+	std::sort( cg_staticSolids.begin(), cg_staticSolids.end(),
+	           []( const solidBox_t &a, const solidBox_t &b ) { return a.mins[ 0 ] < b.mins[ 0 ]; } );
 }
 
 /*
 ====================
-CG_ClipMoveToEntities
+CG_ClipMoveToEntity
 
+Returns true if the trace is all solid and no other entity needs to be checked
 ====================
 */
-static void CG_ClipMoveToEntities( const vec3_t start, const vec3_t mins,
-                                   const vec3_t maxs, const vec3_t end, int skipNumber,
-                                   int mask, int skipmask, trace_t *tr, traceType_t collisionType )
+static bool CG_ClipMoveToEntity( centity_t *cent, const vec3_t start, const vec3_t mins,
+                                 const vec3_t maxs, const vec3_t end, const vec3_t tmins, const vec3_t tmaxs,
+                                 int mask, int skipmask, trace_t *tr, traceType_t collisionType )
 {
-	int           x, zd, zu;
+	entityState_t *ent = &cent->currentState;
 	trace_t       trace;
 	clipHandle_t  cmodel;
-	vec3_t        tmins, tmaxs;
 	vec3_t        bmins, bmaxs;
 	vec3_t        origin, angles;
 
+	if ( ent->solid == SOLID_BMODEL )
+	{
+		// special value for bmodel
+		cmodel = CM_InlineModel( ent->modelindex );
+		VectorCopy( cent->lerpAngles, angles );
+		BG_EvaluateTrajectory( &cent->currentState.pos, cg.physicsTime, origin );
+	}
+	else
+	{
+		CG_SolidEntityBox( ent, cent->lerpOrigin, bmins, bmaxs );
+
+		if( !BoundsIntersect( bmins, bmaxs, tmins, tmaxs ) )
+			return false;
+
+		cmodel = CM_TempBoxModel( bmins, bmaxs, /* capsule = */ false );
+		VectorCopy( vec3_origin, angles );
+		VectorCopy( vec3_origin, origin );
+	}
+
+	switch ( collisionType )
+	{
+	case traceType_t::TT_CAPSULE:
+	case traceType_t::TT_AABB:
+		CM_TransformedBoxTrace( &trace, start, end, mins, maxs, cmodel, mask, skipmask, origin, angles, collisionType );
+		break;
+
+	case traceType_t::TT_BISPHERE:
+		CM_TransformedBiSphereTrace( &trace, start, end, mins[ 0 ], maxs[ 0 ], cmodel,
+		                                  mask, skipmask, origin );
+		break;
+
+	default: // Shouldn't Happen
+		ASSERT_UNREACHABLE();
+	}
+
+	if ( trace.allsolid || trace.fraction < tr->fraction )
+	{
+		trace.entityNum = ent->number;
+
+		if ( tr->lateralFraction < trace.lateralFraction )
+		{
+			float oldLateralFraction = tr->lateralFraction;
+			*tr = trace;
+			tr->lateralFraction = oldLateralFraction;
+		}
+		else
+		{
+			*tr = trace;
+		}
+	}
+	else if ( trace.startsolid )
+	{
+		tr->startsolid = true;
+		tr->entityNum = ent->number;
+	}
+
+	return tr->allsolid;
+}
+
+/*
+====================
+CG_ClipMoveToEntities
+
+====================
+*/
+static void CG_ClipMoveToEntities( const vec3_t start, const vec3_t mins,
+                                   const vec3_t maxs, const vec3_t end, int skipNumber,
+                                   int mask, int skipmask, trace_t *tr, traceType_t collisionType )
+{
+	vec3_t tmins, tmaxs;
+
 	// calculate bounding box of the trace
 	ClearBounds( tmins, tmaxs );
 	AddPointToBounds( start, tmins, tmaxs );
@@ -112,100 +281,52 @@ static void CG_ClipMoveToEntities( const vec3_t start, const vec3_t mins,
 	if( maxs )
 		VectorAdd( maxs, tmaxs, tmaxs );
 
-	for ( centity_t *cent : cg_solidEntities )
-	{
-		entityState_t *ent = &cent->currentState;
+	// no box starting further left than this can reach the trace
+	float left = tmins[ 0 ] - cg_staticSolidsMaxWidth;
+	const solidBox_t *box = std::lower_bound( cg_staticSolids.begin(), cg_staticSolids.end(), left,
+	                                          []( const solidBox_t &b, float x ) { return b.mins[ 0 ] < x; } );
 
-		if ( ent->number == skipNumber )
-		{
-			continue;
-		}
+	for ( ; box != cg_staticSolids.end() && box->mins[ 0 ] <= tmaxs[ 0 ]; box++ )
+	{
+		centity_t *cent = box->cent;
 
-		if ( !( cent->contents & mask ) )
+		if ( cent->currentState.number == skipNumber ||
+		     !( cent->contents & mask ) || ( cent->contents & skipmask ) )
 		{
 			continue;
 		}
 
-		if ( cent->contents & skipmask )
+		if ( !BoundsIntersect( box->mins, box->maxs, tmins, tmaxs ) )
 		{
 			continue;
 		}
 
-		if ( ent->solid == SOLID_BMODEL )
+		if ( CG_ClipMoveToEntity( cent, start, mins, maxs, end, tmins, tmaxs, mask, skipmask, tr, collisionType ) )
 		{
-			// special value for bmodel
-			cmodel = CM_InlineModel( ent->modelindex );
-			VectorCopy( cent->lerpAngles, angles );
-			BG_EvaluateTrajectory( &cent->currentState.pos, cg.physicsTime, origin );
+			return;
 		}
-		else
-		{
-			if ( ent->eType == entityType_t::ET_BUILDABLE )
-			{
-				BG_BuildableBoundingBox( ent->modelindex, bmins, bmaxs );
-			}
-			else
-			{
-				// encoded bbox
-				x = ( ent->solid & 255 );
-				zd = ( ( ent->solid >> 8 ) & 255 );
-				zu = ( ( ent->solid >> 16 ) & 255 ) - 32;
-
-				bmins[ 0 ] = bmins[ 1 ] = -x;
-				bmaxs[ 0 ] = bmaxs[ 1 ] = x;
-				bmins[ 2 ] = -zd;
-				bmaxs[ 2 ] = zu;
-			}
-
-			VectorAdd( cent->lerpOrigin, bmins, bmins );
-			VectorAdd( cent->lerpOrigin, bmaxs, bmaxs );
-
-			if( !BoundsIntersect( bmins, bmaxs, tmins, tmaxs ) )
-				continue;
+	}
 
-			cmodel = CM_TempBoxModel( bmins, bmaxs, /* capsule = */ false );
-			VectorCopy( vec3_origin, angles );
-			VectorCopy( vec3_origin, origin );
-		}
+	for ( centity_t *cent : cg_solidEntities )
+	{
+		entityState_t *ent = &cent->currentState;
 
-		switch ( collisionType )
+		if ( ent->number == skipNumber )
 		{
-		case traceType_t::TT_CAPSULE:
-		case traceType_t::TT_AABB:
-			CM_TransformedBoxTrace( &trace, start, end, mins, maxs, cmodel, mask, skipmask, origin, angles, collisionType );
-			break;
-
-		case traceType_t::TT_BISPHERE:
-			CM_TransformedBiSphereTrace( &trace, start, end, mins[ 0 ], maxs[ 0 ], cmodel,
-			                                  mask, skipmask, origin );
-			break;
-
-		default: // Shouldn't Happen
-			ASSERT_UNREACHABLE();
+			continue;
 		}
 
-		if ( trace.allsolid || trace.fraction < tr->fraction )
+		if ( !( cent->contents & mask ) )
 		{
-			trace.entityNum = ent->number;
-
-			if ( tr->lateralFraction < trace.lateralFraction )
-			{
-				float oldLateralFraction = tr->lateralFraction;
-				*tr = trace;
-				tr->lateralFraction = oldLateralFraction;
-			}
-			else
-			{
-				*tr = trace;
-			}
+			continue;
 		}
-		else if ( trace.startsolid )
+
+		if ( cent->contents & skipmask )
 		{
-			tr->startsolid = true;
-			tr->entityNum = ent->number;
+			continue;
 		}
 
-		if ( tr->allsolid )
+		if ( CG_ClipMoveToEntity( cent, start, mins, maxs, end, tmins, tmaxs, mask, skipmask, tr, collisionType ) )
 		{
 			return;
 		}
@@ -283,7 +404,7 @@ int   CG_PointContents( const vec3_t point, int passEntityNum )
 
 	contents = CM_PointContents( point, 0 );
 
-	for ( centity_t *cent : cg_solidEntities )
+	for ( centity_t *cent : cg_solidBrushEntities )
 	{
 		entityState_t *ent = &cent->currentState;
 
@@ -382,25 +503,27 @@ static void CG_InterpolatePlayerState( bool grabAngles )
 CG_TouchTriggerPrediction
 
 Predict push triggers and items
+Returns true if the player is touching a teleporter
 =========================
 */
-static void CG_TouchTriggerPrediction()
+static bool CG_TouchTriggerPrediction()
 {
 	trace_t       trace;
 	clipHandle_t  cmodel;
 	bool      spectator;
+	bool      touchedTeleporter = false;
 
 	// dead clients don't activate triggers
 	if ( cg.predictedPlayerState.stats[ STAT_HEALTH ] <= 0 )
 	{
-		return;
+		return false;
 	}
 
 	spectator = ( cg.predictedPlayerState.pm_type == PM_SPECTATOR );
 
 	if ( cg.predictedPlayerState.pm_type != PM_NORMAL && !spectator )
 	{
-		return;
+		return false;
 	}
 
 	for ( centity_t *cent : cg_triggerEntities )
@@ -428,9 +551,11 @@ static void CG_TouchTriggerPrediction()
 
 		if ( ent->eType == entityType_t::ET_TELEPORTER )
 		{
-			cg.hyperspace = true;
+			touchedTeleporter = true;
 		}
 	}
+
+	return touchedTeleporter;
 }
 
 static int CG_IsUnacceptableError( playerState_t *ps, playerState_t *pps )
@@ -580,6 +705,65 @@ static int CG_IsUnacceptableError( playerState_t *ps, playerState_t *pps )
 	return 0;
 }
 
+/*
+=================
+CG_InvalidatePredictionCheckpoints
+=================
+*/
+static void CG_InvalidatePredictionCheckpoints()
+{
+	cg.firstCheckpointCommand = 1;
+	cg.lastPredictedCommand = 0;
+}
+
+/*
+=================
+CG_PredictionCheckpoint
+
+Returns the checkpoint of a command, nullptr if there is no valid one
+=================
+*/
+static predictionCheckpoint_t *CG_PredictionCheckpoint( int cmdNum )
+{
+	if ( cmdNum <= 0 || cmdNum < cg.firstCheckpointCommand || cmdNum > cg.lastPredictedCommand )
+	{
+		return nullptr;
+	}
+
+	predictionCheckpoint_t *checkpoint = &cg.predictionCheckpoints[ cmdNum % NUM_PREDICTION_CHECKPOINTS ];
+
+	return checkpoint->cmdNum == cmdNum ? checkpoint : nullptr;
+}
+
+/*
+=================
+CG_SavePredictionCheckpoint
+
+Remember the state after predicting a command
+=================
+*/
+static void CG_SavePredictionCheckpoint( int cmdNum, bool touchedTeleporter )
+{
+	if ( cg.lastPredictedCommand <= 0 || cmdNum != cg.lastPredictedCommand + 1 )
+	{
+		// checkpoints have to be consecutive
+		cg.firstCheckpointCommand = cmdNum;
+	}
+	else if ( cmdNum - cg.firstCheckpointCommand >= NUM_PREDICTION_CHECKPOINTS )
+	{
+		cg.firstCheckpointCommand = cmdNum - NUM_PREDICTION_CHECKPOINTS + 1;
+	}
+
+	predictionCheckpoint_t *checkpoint = &cg.predictionCheckpoints[ cmdNum % NUM_PREDICTION_CHECKPOINTS ];
+
+	checkpoint->cmdNum = cmdNum;
+	checkpoint->ps = cg.predictedPlayerState;
+	checkpoint->pmext = cg.pmext;
+	checkpoint->touchedTeleporter = touchedTeleporter;
+
+	cg.lastPredictedCommand = cmdNum;
+}
+
 /*
 =================
 CG_PredictPlayerState
@@ -598,9 +782,9 @@ but we simulate all unacknowledged commands each time, not just the new ones.
 This means that in case of an Internet connection, quite a few pmoves may be
 issued each frame.
 
-OPTIMIZE: Don't re-simulate unless the newly arrived snapshot's playerState_t
-differs from the predicted one.  This would require saving all intermediate
-playerState_ts during prediction.
+With cg_optimizePrediction, the state after every predicted command is kept
+as a checkpoint. Prediction resumes from the newest checkpoint as long as the
+snapshots agree with the checkpoints, so usually only the new commands are run.
 
 We detect prediction errors and allow them to be decayed off over several frames
 to ease the jerk.
@@ -612,7 +796,7 @@ void CG_PredictPlayerState()
 	playerState_t oldPlayerState;
 	usercmd_t     oldestCmd;
 	usercmd_t     latestCmd;
-	int           stateIndex = 0, predictCmd = 0;
+	int           firstCmd;
 
 	cg.hyperspace = false; // will be set if touching a trigger_teleport
 
@@ -710,58 +894,57 @@ void CG_PredictPlayerState()
 	// Like the comments described above, a player's state is entirely
 	// re-predicted from the last valid snapshot every client frame, which
 	// can be really, really, really slow.  Every old command has to be
-	// run again.  For every client frame that is *not* directly after a
-	// snapshot, this is unnecessary, since we have no new information.
-	// For those, we'll play back the predictions from the last frame and
-	// predict only the newest commands.  Essentially, we'll be doing
-	// an incremental predict instead of a full predict.
+	// run again, and on high ping connections there are a lot of them.
 	//
-	// If we have a new snapshot, we can compare its player state's command
-	// time to the command times in the queue to find a match.  If we find
-	// a matching state, and the predicted version has not deviated, we can
-	// use the predicted state as a base - and also do an incremental predict.
+	// Instead, the state after each predicted command is kept as a
+	// checkpoint. For every client frame that is *not* directly after a
+	// snapshot we have no new information, so prediction simply continues
+	// from the newest checkpoint with the new commands.
 	//
-	// With this method, we get incremental predicts on every client frame
-	// except a frame following a new snapshot in which there was a prediction
-	// error.  This yields anywhere from a 15% to 40% performance increase,
-	// depending on how much of a bottleneck the CPU is.
+	// If we have a new snapshot, we look for the checkpoint of the command
+	// the server ran last. If it agrees with the snapshot within the
+	// tolerances of CG_IsUnacceptableError, the checkpoints after it are
+	// still good and we continue from the newest one as well. Only a
+	// prediction error or a teleport causes a full predict.
+	firstCmd = current - CMD_BACKUP + 1;
+
 	if ( cg_optimizePrediction.Get() )
 	{
+		predictionCheckpoint_t *resume = nullptr;
+
 		if ( cg.nextFrameTeleport || cg.thisFrameTeleport )
 		{
 			// do a full predict
-			cg.lastPredictedCommand = 0;
-			cg.stateTail = cg.stateHead;
-			predictCmd = current - CMD_BACKUP + 1;
+			CG_InvalidatePredictionCheckpoints();
 		}
 		// cg.physicsTime is the current snapshot's serverTime if it's the same
 		// as the last one
 		else if ( cg.physicsTime == cg.lastServerTime )
 		{
 			// we have no new information, so do an incremental predict
-			predictCmd = cg.lastPredictedCommand + 1;
+			resume = CG_PredictionCheckpoint( cg.lastPredictedCommand );
 		}
 		else
 		{
-			// we have a new snapshot
-			int      errorcode;
-			bool error = true;
+			// we have a new snapshot, look for the checkpoint whose commandTime
+			// matches the snapshot player state's commandTime
+			predictionCheckpoint_t *confirmed = nullptr;
 
-			// loop through the saved states queue
-			for ( int i = cg.stateHead; i != cg.stateTail;
-			      i = ( i + 1 ) % NUM_SAVED_STATES )
+			for ( int i = cg.firstCheckpointCommand; i <= cg.lastPredictedCommand; i++ )
 			{
-				// if we find a predicted state whose commandTime matches the snapshot
-				// player state's commandTime
-				if ( cg.savedPmoveStates[ i ].commandTime !=
-				     cg.predictedPlayerState.commandTime )
+				predictionCheckpoint_t *checkpoint = CG_PredictionCheckpoint( i );
+
+				if ( checkpoint && checkpoint->ps.commandTime == cg.predictedPlayerState.commandTime )
 				{
-					continue;
+					confirmed = checkpoint;
+					break;
 				}
+			}
 
-				// make sure the state differences are acceptable
-				errorcode = CG_IsUnacceptableError( &cg.predictedPlayerState,
-				                                    &cg.savedPmoveStates[ i ] );
+			// make sure the state differences are acceptable
+			if ( confirmed )
+			{
+				int errorcode = CG_IsUnacceptableError( &cg.predictedPlayerState, &confirmed->ps );
 
 				if ( errorcode )
 				{
@@ -770,39 +953,53 @@ void CG_PredictPlayerState()
 						Log::Debug( "error code %d at %d", errorcode, cg.time );
 					}
 
-					break;
+					confirmed = nullptr;
 				}
+			}
 
-				// this one is almost exact, so we'll copy it in as the starting point
-				*cg_pmove.ps = cg.savedPmoveStates[ i ];
-				// advance the head
-				cg.stateHead = ( i + 1 ) % NUM_SAVED_STATES;
-
-				// set the next command to predict
-				predictCmd = cg.lastPredictedCommand + 1;
+			if ( confirmed )
+			{
+				// the server has handled everything up to this checkpoint
+				cg.firstCheckpointCommand = confirmed->cmdNum;
+				confirmed->touchedTeleporter = false;
 
-				// a saved state matched, so flag it
-				error = false;
-				break;
+				resume = CG_PredictionCheckpoint( cg.lastPredictedCommand );
 			}
+		}
+
+		// the commands after the checkpoint must still be available
+		if ( resume && resume->cmdNum >= firstCmd - 1 )
+		{
+			*cg_pmove.ps = resume->ps;
+			cg.pmext = resume->pmext;
 
-			// if no saved states matched
-			if ( error )
+			// a full predict would have touched the triggers of all these states
+			for ( int i = cg.firstCheckpointCommand; i <= resume->cmdNum; i++ )
 			{
-				// do a full predict
-				cg.lastPredictedCommand = 0;
-				cg.stateTail = cg.stateHead;
-				predictCmd = current - CMD_BACKUP + 1;
+				if ( CG_PredictionCheckpoint( i )->touchedTeleporter )
+				{
+					cg.hyperspace = true;
+				}
 			}
+
+			firstCmd = resume->cmdNum + 1;
+		}
+		else
+		{
+			// do a full predict
+			CG_InvalidatePredictionCheckpoints();
 		}
 
 		// keep track of the server time of the last snapshot so we
 		// know when we're starting from a new one in future calls
 		cg.lastServerTime = cg.physicsTime;
-		stateIndex = cg.stateHead;
+	}
+	else
+	{
+		CG_InvalidatePredictionCheckpoints();
 	}
 
-	for ( cmdNum = current - CMD_BACKUP + 1; cmdNum <= current; cmdNum++ )
+	for ( cmdNum = firstCmd; cmdNum <= current; cmdNum++ )
 	{
 		// get the command
 		trap_GetUserCmd( cmdNum, &cg_pmove.cmd );
@@ -914,36 +1111,21 @@ void CG_PredictPlayerState()
 			                            cg.pmoveParams.msec ) * cg.pmoveParams.msec;
 		}
 
-		if ( !cg_optimizePrediction.Get() )
+		Pmove( &cg_pmove );
+
+		// add push trigger movement effects
+		bool touchedTeleporter = CG_TouchTriggerPrediction();
+
+		if ( touchedTeleporter )
 		{
-			Pmove( &cg_pmove );
+			cg.hyperspace = true;
 		}
-		else if ( cg_optimizePrediction.Get() && ( cmdNum >= predictCmd ||
-		          ( stateIndex + 1 ) % NUM_SAVED_STATES == cg.stateHead ) )
-		{
-			Pmove( &cg_pmove );
-			// record the last predicted command
-			cg.lastPredictedCommand = cmdNum;
 
-			// if we haven't run out of space in the saved states queue
-			if ( ( stateIndex + 1 ) % NUM_SAVED_STATES != cg.stateHead )
-			{
-				// save the state for the false case ( of cmdNum >= predictCmd )
-				// in later calls to this function
-				cg.savedPmoveStates[ stateIndex ] = *cg_pmove.ps;
-				stateIndex = ( stateIndex + 1 ) % NUM_SAVED_STATES;
-				cg.stateTail = stateIndex;
-			}
-		}
-		else
+		if ( cg_optimizePrediction.Get() )
 		{
-			*cg_pmove.ps = cg.savedPmoveStates[ stateIndex ];
-			stateIndex = ( stateIndex + 1 ) % NUM_SAVED_STATES;
+			CG_SavePredictionCheckpoint( cmdNum, touchedTeleporter );
 		}
 
-		// add push trigger movement effects
-		CG_TouchTriggerPrediction();
-
 		// check for predictable events that changed from previous predictions
 		//CG_CheckChangedPredictableEvents(&cg.predictedPlayerState);
 	}
@@ -34,6 +34,12 @@ Maryland 20850 USA.
 
 #include "cg_local.h"
 
+// The value of a column passed to a formatter, counted from 1
+static const char *DataValue( const std::vector<std::string> &data, size_t column )
+{
+	return column - 1 < data.size() ? data[ column - 1 ].c_str() : "";
+}
+
 static int GCD( int a, int b )
 {
 	int c;
@@ -65,10 +71,10 @@ static const char *DisplayAspectString( int w, int h )
 	return va( "%d:%d", w, h );
 }
 
-static void CG_Rocket_DFResolution( int handle, const char *data )
+static void CG_Rocket_DFResolution( int handle, const std::vector<std::string> &data )
 {
-	int w = atoi( Info_ValueForKey(data, "1" ) );
-	int h = atoi( Info_ValueForKey(data, "2" ) );
+	int w = atoi( DataValue( data, 1 ) );
+	int h = atoi( DataValue( data, 2 ) );
 
 	if ( w == -1 || h == -1 )
 	{
@@ -80,37 +86,37 @@ static void CG_Rocket_DFResolution( int handle, const char *data )
 	BG_Free( aspectRatio );
 }
 
-static void CG_Rocket_DFServerPing( int handle, const char *data )
+static void CG_Rocket_DFServerPing( int handle, const std::vector<std::string> &data )
 {
-	const char *str = Info_ValueForKey( data, "1" );
-	Rocket_DataFormatterFormattedData( handle, *str && Str::cisdigit( *str ) ? va( "%s ms", Info_ValueForKey( data, "1" ) ) : "", false );
+	const char *str = DataValue( data, 1 );
+	Rocket_DataFormatterFormattedData( handle, *str && Str::cisdigit( *str ) ? va( "%s ms", DataValue( data, 1 ) ) : "", false );
 }
 
-static void CG_Rocket_DFServerPlayers( int handle, const char *data )
+static void CG_Rocket_DFServerPlayers( int handle, const std::vector<std::string> &data )
 {
 	char max[ 4 ];
-	Q_strncpyz( max, Info_ValueForKey( data, "3" ), sizeof( max ) );
-	Rocket_DataFormatterFormattedData( handle, va( "%s + (%s) / %s", Info_ValueForKey( data, "1" ), Info_ValueForKey( data, "2" ), max ), true );
+	Q_strncpyz( max, DataValue( data, 3 ), sizeof( max ) );
+	Rocket_DataFormatterFormattedData( handle, va( "%s + (%s) / %s", DataValue( data, 1 ), DataValue( data, 2 ), max ), true );
 }
 
-static void CG_Rocket_DFPlayerName( int handle, const char *data )
+static void CG_Rocket_DFPlayerName( int handle, const std::vector<std::string> &data )
 {
-	Rocket_DataFormatterFormattedData( handle, va("<span class=\"playername\">%s</span>", CG_Rocket_QuakeToRML( cgs.clientinfo[ atoi( Info_ValueForKey( data, "1" ) ) ].name ) ) , false );
+	Rocket_DataFormatterFormattedData( handle, va("<span class=\"playername\">%s</span>", CG_Rocket_QuakeToRML( cgs.clientinfo[ atoi( DataValue( data, 1 ) ) ].name ) ) , false );
 }
 
-static void CG_Rocket_DFUpgradeName( int handle, const char *data )
+static void CG_Rocket_DFUpgradeName( int handle, const std::vector<std::string> &data )
 {
-	Rocket_DataFormatterFormattedData( handle, BG_Upgrade( atoi( Info_ValueForKey( data, "1" ) ) )->humanName, true );
+	Rocket_DataFormatterFormattedData( handle, BG_Upgrade( atoi( DataValue( data, 1 ) ) )->humanName, true );
 }
 
-static void CG_Rocket_DFVotePlayer( int handle, const char *data )
+static void CG_Rocket_DFVotePlayer( int handle, const std::vector<std::string> &data )
 {
-	Rocket_DataFormatterFormattedData( handle, va("<button onClick=\"Events.pushevent('exec set ui_dialogCvar1 %s;exec rocket ui/dialogs/editplayer.rml load; exec rocket editplayer show', event)\">vote/moderate</button>", cgs.clientinfo[ atoi( Info_ValueForKey( data, "1" ) ) ].name ) , false );
+	Rocket_DataFormatterFormattedData( handle, va("<button onClick=\"Events.pushevent('exec set ui_dialogCvar1 %s;exec rocket ui/dialogs/editplayer.rml load; exec rocket editplayer show', event)\">vote/moderate</button>", cgs.clientinfo[ atoi( DataValue( data, 1 ) ) ].name ) , false );
 }
 
-static void CG_Rocket_DFVoteMap( int handle, const char *data )
+static void CG_Rocket_DFVoteMap( int handle, const std::vector<std::string> &data )
 {
-	size_t mapIndex = atoi( Info_ValueForKey( data, "1" ) );
+	size_t mapIndex = atoi( DataValue( data, 1 ) );
 	if ( mapIndex < rocketInfo.data.mapList.size() )
 	{
 		Rocket_DataFormatterFormattedData(
@@ -126,25 +132,25 @@ static void CG_Rocket_DFVoteMap( int handle, const char *data )
 	}
 }
 
-static void CG_Rocket_DFWeaponName( int handle, const char *data )
+static void CG_Rocket_DFWeaponName( int handle, const std::vector<std::string> &data )
 {
-	Rocket_DataFormatterFormattedData( handle, BG_Weapon( atoi( Info_ValueForKey( data, "1" ) ) )->humanName, true );
+	Rocket_DataFormatterFormattedData( handle, BG_Weapon( atoi( DataValue( data, 1 ) ) )->humanName, true );
 }
 
-static void CG_Rocket_DFClassName( int handle, const char *data )
+static void CG_Rocket_DFClassName( int handle, const std::vector<std::string> &data )
 {
-	Rocket_DataFormatterFormattedData( handle, BG_Class( atoi( Info_ValueForKey( data, "1" ) ) )->name, true );
+	Rocket_DataFormatterFormattedData( handle, BG_Class( atoi( DataValue( data, 1 ) ) )->name, true );
 }
 
-static void CG_Rocket_DFServerLabel( int handle, const char *data )
+static void CG_Rocket_DFServerLabel( int handle, const std::vector<std::string> &data )
 {
-	const char *str = Info_ValueForKey( data, "1" );
-	Rocket_DataFormatterFormattedData( handle, *data ? ++str : "&nbsp;", false );
+	const char *str = DataValue( data, 1 );
+	Rocket_DataFormatterFormattedData( handle, *str ? ++str : "&nbsp;", false );
 }
 
-static void CG_Rocket_DFGWeaponDamage( int handle, const char *data )
+static void CG_Rocket_DFGWeaponDamage( int handle, const std::vector<std::string> &data )
 {
-	weapon_t weapon = (weapon_t) atoi( Info_ValueForKey( data, "1" ) );
+	weapon_t weapon = (weapon_t) atoi( DataValue( data, 1 ) );
 	int      width = 0;
 
 	switch( weapon )
@@ -165,9 +171,9 @@ static void CG_Rocket_DFGWeaponDamage( int handle, const char *data )
 	Rocket_DataFormatterFormattedData( handle, va( "<div class=\"barValue\" style=\"width:%d%%;\"></div>", width ), false );
 }
 
-static void CG_Rocket_DFGWeaponRateOfFire( int handle, const char *data )
+static void CG_Rocket_DFGWeaponRateOfFire( int handle, const std::vector<std::string> &data )
 {
-	weapon_t weapon = (weapon_t) atoi( Info_ValueForKey( data, "1" ) );
+	weapon_t weapon = (weapon_t) atoi( DataValue( data, 1 ) );
 	int      width = 0;
 
 	switch( weapon )
@@ -188,9 +194,9 @@ static void CG_Rocket_DFGWeaponRateOfFire( int handle, const char *data )
 	Rocket_DataFormatterFormattedData( handle, va( "<div class=\"barValue\" style=\"width:%d%%;\"></div>", width ), false );
 }
 
-static void CG_Rocket_DFGWeaponRange( int handle, const char *data )
+static void CG_Rocket_DFGWeaponRange( int handle, const std::vector<std::string> &data )
 {
-	weapon_t weapon = (weapon_t) atoi( Info_ValueForKey( data, "1" ) );
+	weapon_t weapon = (weapon_t) atoi( DataValue( data, 1 ) );
 	int      width = 0;
 
 	switch( weapon )
@@ -211,9 +217,9 @@ static void CG_Rocket_DFGWeaponRange( int handle, const char *data )
 	Rocket_DataFormatterFormattedData( handle, va( "<div class=\"barValue\" style=\"width:%d%%;\"></div>", width ), false );
 }
 
-static void CG_Rocket_DFLevelShot( int handle, const char *data )
+static void CG_Rocket_DFLevelShot( int handle, const std::vector<std::string> &data )
 {
-	Rocket_DataFormatterFormattedData( handle, va( "<img class=\"levelshot\" src=\"/levelshots/%s\"/>", Info_ValueForKey( data, "1" ) ), false );
+	Rocket_DataFormatterFormattedData( handle, va( "<img class=\"levelshot\" src=\"/levelshots/%s\"/>", DataValue( data, 1 ) ), false );
 }
 
 static score_t *ScoreFromClientNum( int clientNum )
@@ -231,9 +237,9 @@ static score_t *ScoreFromClientNum( int clientNum )
 	return nullptr;
 }
 
-static void CG_Rocket_DFGearOrReady( int handle, const char *data )
+static void CG_Rocket_DFGearOrReady( int handle, const std::vector<std::string> &data )
 {
-	int clientNum = atoi( Info_ValueForKey( data, "1" ) );
+	int clientNum = atoi( DataValue( data, 1 ) );
 	if ( cg.intermissionStarted )
 	{
 		if ( CG_ClientIsReady( clientNum ) )
@@ -267,7 +273,7 @@ static void CG_Rocket_DFGearOrReady( int handle, const char *data )
 struct dataFormatterCmd_t
 {
 	const char *name;
-	void ( *exec ) ( int handle, const char *data );
+	void ( *exec ) ( int handle, const std::vector<std::string> &data );
 };
 
 static const dataFormatterCmd_t dataFormatterCmdList[] =
@@ -298,16 +304,15 @@ static int dataFormatterCmdCmp( const void *a, const void *b )
 
 void CG_Rocket_FormatData( int handle )
 {
-	static char name[ 200 ], data[ BIG_INFO_STRING ];
+	const std::vector<std::string> *data;
+	const char *name = Rocket_DataFormatterRawData( handle, &data );
 	dataFormatterCmd_t *cmd;
 
-	Rocket_DataFormatterRawData( handle, name, sizeof( name ), data, sizeof( data ) );
-
 	cmd = (dataFormatterCmd_t*) bsearch( name, dataFormatterCmdList, dataFormatterCmdListCount, sizeof( dataFormatterCmd_t ), dataFormatterCmdCmp );
 
-	if ( cmd )
+	if ( cmd && data )
 	{
-		cmd->exec( handle, data );
+		cmd->exec( handle, *data );
 	}
 }
 
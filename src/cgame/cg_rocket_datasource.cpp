@@ -33,6 +33,7 @@ Maryland 20850 USA.
 */
 
 #include "cg_local.h"
+#include "ServerListModel.h"
 
 static bool AddToServerList( const char *name, const char *label, int clients, int bots, int ping, int maxClients, char *mapName, char *addr, int netSrc )
 {
@@ -51,6 +52,8 @@ static bool AddToServerList( const char *name, const char *label, int clients, i
 	node = &rocketInfo.data.servers[ netSrc ][ rocketInfo.data.serverCount[ netSrc ] ];
 
 	node->name = BG_strdup( name );
+	node->cleanName = BG_strdup( name );
+	Color::StripColors( node->cleanName );
 	node->clients = clients;
 	node->bots = bots;
 	node->ping = ping;
@@ -63,6 +66,8 @@ static bool AddToServerList( const char *name, const char *label, int clients, i
 	return true;
 }
 
+static ServerListModel &CG_Rocket_ServerListModel( int netSrc );
+
 static void CG_Rocket_SetServerListServer( const char *table, int index )
 {
 	int netSrc = CG_StringToNetSource( table );
@@ -72,7 +77,8 @@ static void CG_Rocket_SetServerListServer( const char *table, int index )
 		return;
 	}
 
-	rocketInfo.data.serverIndex[ netSrc ] = index;
+	// rows are in the order of the sorted and filtered view
+	rocketInfo.data.serverIndex[ netSrc ] = CG_Rocket_ServerListModel( netSrc ).Item( index );
 	rocketInfo.currentNetSrc = netSrc;
 	CG_Rocket_BuildServerInfo();
 }
@@ -80,7 +86,6 @@ static void CG_Rocket_SetServerListServer( const char *table, int index )
 void CG_Rocket_BuildServerInfo()
 {
 	static char serverInfoText[ MAX_SERVERSTATUS_LINES ];
-	char buf[ MAX_INFO_STRING ];
 	const char *p;
 	server_t *server;
 	int netSrc = rocketInfo.currentNetSrc;
@@ -97,8 +102,6 @@ void CG_Rocket_BuildServerInfo()
 		return;
 	}
 
-	buf[0] = 0;
-
 	rocketInfo.serverStatusLastRefresh = rocketInfo.realtime;
 
 	if ( !rocketInfo.data.buildingServerInfo )
@@ -127,10 +130,7 @@ void CG_Rocket_BuildServerInfo()
 
 			if ( key[ 0 ] )
 			{
-				Info_SetValueForKey( buf, "cvar", key, false );
-				Info_SetValueForKey( buf, "value", value, false );
-				Rocket_DSAddRow( "server_browser", "serverInfo", buf );
-				*buf = '\0';
+				Rocket_DSAddRow( "server_browser", "serverInfo", RocketDataRow().String( "cvar", key ).String( "value", value ) );
 			}
 
 			else
@@ -161,11 +161,8 @@ void CG_Rocket_BuildServerInfo()
 
 		Q_strncpyz( name, start + 1, end - start );
 		start = end = NULL;
-		Info_SetValueForKey( buf, "num", va( "%d", i++ ), false );
-		Info_SetValueForKeyRocket( buf, "name", name, false );
-		Info_SetValueForKey( buf, "score", va( "%d", score ), false );
-		Info_SetValueForKey( buf, "ping", va( "%d", ping ), false );
-		Rocket_DSAddRow( "server_browser", "serverPlayers", buf );
+		Rocket_DSAddRow( "server_browser", "serverPlayers", RocketDataRow()
+			.Int( "num", i++ ).String( "name", name ).Int( "score", score ).Int( "ping", ping ) );
 
 		while ( *p )
 		{
@@ -190,11 +187,8 @@ void CG_Rocket_BuildServerInfo()
 
 				Q_strncpyz( name, start + 1, end - start );
 				start = end = NULL;
-				Info_SetValueForKey( buf, "num", va( "%d", i++ ), false );
-				Info_SetValueForKeyRocket( buf, "name", name, false );
-				Info_SetValueForKey( buf, "score", va( "%d", score ), false );
-				Info_SetValueForKey( buf, "ping", va( "%d", ping ), false );
-				Rocket_DSAddRow( "server_browser", "serverPlayers", buf );
+				Rocket_DSAddRow( "server_browser", "serverPlayers", RocketDataRow()
+					.Int( "num", i++ ).String( "name", name ).Int( "score", score ).Int( "ping", ping ) );
 			}
 
 			if ( value[ 0 ] )
@@ -216,11 +210,8 @@ void CG_Rocket_BuildServerInfo()
 
 				Q_strncpyz( name, start + 1, end - start );
 				start = end = NULL;
-				Info_SetValueForKey( buf, "num", va( "%d", i++ ), false );
-				Info_SetValueForKeyRocket( buf, "name", name, false );
-				Info_SetValueForKey( buf, "score", va( "%d", score ), false );
-				Info_SetValueForKey( buf, "ping", va( "%d", ping ), false );
-				Rocket_DSAddRow( "server_browser", "serverPlayers", buf );
+				Rocket_DSAddRow( "server_browser", "serverPlayers", RocketDataRow()
+					.Int( "num", i++ ).String( "name", name ).Int( "score", score ).Int( "ping", ping ) );
 			}
 		}
 
@@ -238,15 +229,97 @@ static void CG_Rocket_BuildServerList( const char *args )
 	CG_Rocket_BuildServerList();
 }
 
+static RocketDataRow ServerRow( const server_t &server )
+{
+	RocketDataRow row;
+
+	row.String( "name", server.name )
+	   .Int( "players", server.clients )
+	   .Int( "bots", server.bots )
+	   .Int( "ping", server.ping )
+	   .Int( "maxClients", server.maxClients )
+	   .String( "addr", server.addr )
+	   .String( "label", server.label )
+	   .String( "map", server.mapName );
+
+	return row;
+}
+
+/*
+ * The servers of every source are only ever appended to rocketInfo.data.servers,
+ * the model keeps them sorted by every key and tracks which rows of the table
+ * show which server, so that new servers and filter changes only add or remove
+ * the rows that changed.
+ */
+enum serverSortKey_t
+{
+	SERVER_SORT_PING,
+	SERVER_SORT_NAME,
+	SERVER_SORT_PLAYERS,
+	SERVER_SORT_MAP,
+
+	SERVER_SORT_NUM_KEYS
+};
+
+static const char *const serverSortKeyNames[ SERVER_SORT_NUM_KEYS ] =
+{
+	"ping",
+	"name",
+	"players",
+	"map",
+};
+
+static ServerListModel &CG_Rocket_ServerListModel( int netSrc )
+{
+	static std::vector<ServerListModel> models;
+
+	if ( models.empty() )
+	{
+		models.reserve( AS_NUM_TYPES );
+
+		for ( int i = AS_LOCAL; i < AS_NUM_TYPES; ++i )
+		{
+			const server_t *servers = rocketInfo.data.servers[ i ];
+
+			models.emplace_back( std::vector<ServerListModel::compare_type>{
+				[ servers ]( int a, int b ) { return servers[ a ].ping < servers[ b ].ping; },
+				[ servers ]( int a, int b ) { return Q_stricmp( servers[ a ].cleanName, servers[ b ].cleanName ) < 0; },
+				[ servers ]( int a, int b ) { return servers[ a ].clients < servers[ b ].clients; },
+				[ servers ]( int a, int b ) { return Q_stricmp( servers[ a ].mapName, servers[ b ].mapName ) < 0; },
+			} );
+
+			ServerListModel &model = models.back();
+			const char *table = CG_NetSourceToString( i );
+
+			model.onInsert = [ servers, table ]( int row, int item ) {
+				Rocket_DSInsertRow( "server_browser", table, row, ServerRow( servers[ item ] ) );
+			};
+
+			model.onRemove = [ table ]( int row ) {
+				Rocket_DSRemoveRow( "server_browser", table, row );
+			};
+
+			model.onReset = [ servers, table, &model ]() {
+				Rocket_DSClearTable( "server_browser", table );
+
+				for ( int row = 0; row < model.NumRows(); ++row )
+				{
+					Rocket_DSAddRow( "server_browser", table, ServerRow( servers[ model.Item( row ) ] ) );
+				}
+			};
+		}
+	}
+
+	return models[ netSrc ];
+}
+
 void CG_Rocket_BuildServerList()
 {
-	char data[ MAX_INFO_STRING ] = { 0 };
 	int i;
 
 	rocketInfo.data.retrievingServers = true;
 
 	int netSrc = rocketInfo.currentNetSrc;
-	const char *srcName = CG_NetSourceToString( netSrc );
 
 	// Only refresh once every 200 ms
 	if ( rocketInfo.realtime < 200 + rocketInfo.serversLastRefresh )
@@ -290,8 +363,6 @@ void CG_Rocket_BuildServerList()
 		char info[ MAX_STRING_CHARS ];
 		int ping, bots, clients, maxClients;
 
-		memset( &data, 0, sizeof( data ) );
-
 		if ( !trap_LAN_ServerIsVisible( netSrc, i ) )
 		{
 			continue;
@@ -316,120 +387,26 @@ void CG_Rocket_BuildServerList()
 		}
 	}
 
+	ServerListModel &model = CG_Rocket_ServerListModel( netSrc );
+
+	// each new server goes straight to its row in the sorted and filtered view
 	for ( i = oldServerCount; i < rocketInfo.data.serverCount[ netSrc ]; ++i )
 	{
-		if ( rocketInfo.data.servers[ netSrc ][ i ].ping <= 0 )
-		{
-			continue;
-		}
-
-		Info_SetValueForKey( data, "name", rocketInfo.data.servers[ netSrc ][ i ].name, false );
-		Info_SetValueForKey( data, "players", va( "%d", rocketInfo.data.servers[ netSrc ][ i ].clients ), false );
-		Info_SetValueForKey( data, "bots", va( "%d", rocketInfo.data.servers[ netSrc ][ i ].bots ), false );
-		Info_SetValueForKey( data, "ping", va( "%d", rocketInfo.data.servers[ netSrc ][ i ].ping ), false );
-		Info_SetValueForKey( data, "maxClients", va( "%d", rocketInfo.data.servers[ netSrc ][ i ].maxClients ), false );
-		Info_SetValueForKey( data, "addr", rocketInfo.data.servers[ netSrc ][ i ].addr, false );
-		Info_SetValueForKey( data, "label", rocketInfo.data.servers[ netSrc ][ i ].label, false );
-		Info_SetValueForKey( data, "map", rocketInfo.data.servers[ netSrc ][ i ].mapName, false );
-
-		Rocket_DSAddRow( "server_browser", srcName, data );
+		model.Add( i );
 	}
 }
 
-static int ServerListCmpByPing( const void *one, const void *two )
-{
-	server_t* a = ( server_t* ) one;
-	server_t* b = ( server_t* ) two;
-
-	if ( a->ping > b->ping ) return 1;
-
-	if ( b->ping > a->ping ) return -1;
-
-	if ( a->ping == b->ping )  return 0;
-
-	return 0; // silence compiler
-}
-
-static int ServerListCmpByName( const void* one, const void* two )
-{
-	static char cleanName1[ MAX_STRING_CHARS ] = { 0 };
-	static char cleanName2[ MAX_STRING_CHARS ] = { 0 };
-	server_t* a = ( server_t* ) one;
-	server_t* b = ( server_t* ) two;
-
-	Q_strncpyz( cleanName1, a->name, sizeof( cleanName1 ) );
-	Q_strncpyz( cleanName2, b->name, sizeof( cleanName2 ) );
-
-	Color::StripColors( cleanName1 );
-	Color::StripColors( cleanName2 );
-
-	return Q_stricmp( cleanName1, cleanName2 );
-}
-
-static int ServerListCmpByMap( const void* one, const void* two )
-{
-	server_t* a = ( server_t* ) one;
-	server_t* b = ( server_t* ) two;
-
-	return Q_stricmp( a->mapName, b->mapName );
-}
-
-static int ServerListCmpByPlayers( const void* one, const void* two )
-{
-	server_t* a = ( server_t* ) one;
-	server_t* b = ( server_t* ) two;
-
-	if ( a->clients > b->clients ) return 1;
-
-	if ( b->clients > a->clients ) return -1;
-
-	if ( a->clients == b->clients )  return 0;
-
-	return 0; // silence compiler
-}
-
 static void CG_Rocket_SortServerList( const char *name, const char *sortBy )
 {
-	char data[ MAX_INFO_STRING ] = { 0 };
 	int netSrc = CG_StringToNetSource( name );
-	int  i;
-
-	if ( !Q_stricmp( sortBy, "ping" ) )
-	{
-		qsort( rocketInfo.data.servers[ netSrc ], rocketInfo.data.serverCount[ netSrc ], sizeof( server_t ), &ServerListCmpByPing );
-	}
-	else if ( !Q_stricmp( sortBy, "name" ) )
-	{
-		qsort( rocketInfo.data.servers[ netSrc ], rocketInfo.data.serverCount[ netSrc ], sizeof( server_t ), &ServerListCmpByName );
-	}
-	else if ( !Q_stricmp( sortBy, "players" ) )
-	{
-		qsort( rocketInfo.data.servers[ netSrc ], rocketInfo.data.serverCount[ netSrc ], sizeof( server_t ), &ServerListCmpByPlayers );
-	}
-	else if ( !Q_stricmp( sortBy, "map" ) )
-	{
-		qsort( rocketInfo.data.servers[ netSrc ], rocketInfo.data.serverCount[ netSrc ], sizeof( server_t ), &ServerListCmpByMap );
-	}
-
-	Rocket_DSClearTable( "server_browser", name );
 
-	for ( i = 0; i < rocketInfo.data.serverCount[ netSrc ]; ++i )
+	for ( int key = 0; key < SERVER_SORT_NUM_KEYS; ++key )
 	{
-		if ( rocketInfo.data.servers[ netSrc ][ i ].ping <= 0 )
+		if ( !Q_stricmp( sortBy, serverSortKeyNames[ key ] ) )
 		{
-			continue;
+			CG_Rocket_ServerListModel( netSrc ).SetSortKey( key );
+			return;
 		}
-
-		Info_SetValueForKey( data, "name", rocketInfo.data.servers[ netSrc ][ i ].name, false );
-		Info_SetValueForKey( data, "players", va( "%d", rocketInfo.data.servers[ netSrc ][ i ].clients ), false );
-		Info_SetValueForKey( data, "bots", va( "%d", rocketInfo.data.servers[ netSrc ][ i ].bots ), false );
-		Info_SetValueForKey( data, "ping", va( "%d", rocketInfo.data.servers[ netSrc ][ i ].ping ), false );
-		Info_SetValueForKey( data, "maxClients", va( "%d", rocketInfo.data.servers[ netSrc ][ i ].maxClients ), false );
-		Info_SetValueForKey( data, "addr", rocketInfo.data.servers[ netSrc ][ i ].addr, false );
-		Info_SetValueForKey( data, "label", rocketInfo.data.servers[ netSrc ][ i ].label, false );
-		Info_SetValueForKey( data, "map", rocketInfo.data.servers[ netSrc ][ i ].mapName, false );
-
-		Rocket_DSAddRow( "server_browser", name, data );
 	}
 }
 
@@ -446,12 +423,14 @@ void CG_Rocket_CleanUpServerList( const char *table )
 			for ( j = 0; j < rocketInfo.data.serverCount[ i ]; ++j )
 			{
 				BG_Free( rocketInfo.data.servers[ i ][ j ].name );
+				BG_Free( rocketInfo.data.servers[ i ][ j ].cleanName );
 				BG_Free( rocketInfo.data.servers[ i ][ j ].label );
 				BG_Free( rocketInfo.data.servers[ i ][ j ].addr );
 				BG_Free( rocketInfo.data.servers[ i ][ j ].mapName );
 			}
 			rocketInfo.data.serverCount[ i ] = 0;
 			rocketInfo.data.haveServerInfo[ i ].clear();
+			CG_Rocket_ServerListModel( i ).Clear();
 		}
 	}
 }
@@ -460,37 +439,32 @@ static void CG_Rocket_FilterServerList( const char *table, const char *filter )
 {
 	const char *str = ( table && *table ) ? table : CG_NetSourceToString( rocketInfo.currentNetSrc );
 	int netSrc = CG_StringToNetSource( str );
-	int i;
+	const server_t *servers = rocketInfo.data.servers[ netSrc ];
 
-	Rocket_DSClearTable( "server_browser", str );
-
-	for ( i = 0; i < rocketInfo.data.serverCount[ netSrc ]; ++i )
+	if ( !filter || !*filter )
 	{
-		char name[ MAX_INFO_VALUE ];
-
-		Q_strncpyz( name, rocketInfo.data.servers[ netSrc ][ i ].name, sizeof( name ) );
-
-		if ( Q_stristr( Color::StripColors( name ), filter ) )
-		{
-			char data[ MAX_INFO_STRING ] = { 0 };
+		CG_Rocket_ServerListModel( netSrc ).SetFilter( nullptr );
+		return;
+	}
 
-			Info_SetValueForKey( data, "name", rocketInfo.data.servers[ netSrc ][ i ].name, false );
-			Info_SetValueForKey( data, "players", va( "%d", rocketInfo.data.servers[ netSrc ][ i ].clients ), false );
-			Info_SetValueForKey( data, "bots", va( "%d", rocketInfo.data.servers[ netSrc ][ i ].bots ), false );
-			Info_SetValueForKey( data, "ping", va( "%d", rocketInfo.data.servers[ netSrc ][ i ].ping ), false );
-			Info_SetValueForKey( data, "maxClients", va( "%d", rocketInfo.data.servers[ netSrc ][ i ].maxClients ), false );
-			Info_SetValueForKey( data, "addr", rocketInfo.data.servers[ netSrc ][ i ].addr, false );
-			Info_SetValueForKey( data, "label", rocketInfo.data.servers[ netSrc ][ i ].label, false );
+	std::string text = filter;
 
-			Rocket_DSAddRow( "server_browser", str, data );
-		}
-	}
+	CG_Rocket_ServerListModel( netSrc ).SetFilter( [ servers, text ]( int item ) {
+		return Q_stristr( servers[ item ].cleanName, text.c_str() ) != nullptr;
+	} );
 }
 
 static void CG_Rocket_ExecServerList( const char *table )
 {
 	int netSrc = CG_StringToNetSource( table );
-	trap_SendConsoleCommand( va( "connect %s", rocketInfo.data.servers[ netSrc ][ rocketInfo.data.serverIndex[ netSrc ] ].addr ) );
+	int serverIndex = rocketInfo.data.serverIndex[ netSrc ];
+
+	if ( serverIndex < 0 || serverIndex >= rocketInfo.data.serverCount[ netSrc ] )
+	{
+		return;
+	}
+
+	trap_SendConsoleCommand( va( "connect %s", rocketInfo.data.servers[ netSrc ][ serverIndex ].addr ) );
 }
 
 static bool Parse( const char **p, char **out )
@@ -926,9 +900,23 @@ static void CG_Rocket_CleanUpDemoList( const char* )
 	rocketInfo.data.demoCount = 0;
 }
 
+static RocketDataRow PlayerRow( const score_t *score, const clientInfo_t *ci )
+{
+	RocketDataRow row;
+
+	row.Int( "num", score->client )
+	   .Int( "score", score->score )
+	   .Int( "weapon", score->weapon )
+	   .Int( "upgrade", score->upgrade )
+	   .Int( "time", score->time )
+	   .Int( "credits", ci->credit )
+	   .String( "location", CG_ConfigString( CS_LOCATIONS + ci->location ) );
+
+	return row;
+}
+
 void CG_Rocket_BuildPlayerList( const char* )
 {
-	char buf[ MAX_INFO_STRING ] = { 0 };
 	clientInfo_t *ci;
 	score_t *score;
 	int i;
@@ -956,8 +944,7 @@ void CG_Rocket_BuildPlayerList( const char* )
 			continue;
 		}
 
-		Info_SetValueForKey( buf, "num", va( "%d", score->client ), false );
-		Info_SetValueForKey( buf, "score", va( "%d", score->score ), false );
+		RocketDataRow row = PlayerRow( score, ci );
 
 		const char* B = Info_ValueForKey( CG_ConfigString( CS_SERVERINFO ),"B" );
 		const char bot_status = B[ score->client ];
@@ -966,41 +953,35 @@ void CG_Rocket_BuildPlayerList( const char* )
 		if ( bot_status == '-' )
 		{
 			// This player is not a bot.
-			Info_SetValueForKey( buf, "ping", va( "%d", score->ping ), false );
+			row.Int( "ping", score->ping );
 		}
 		// Bot skill can be 0 while spawning, just before skill is set.
 		else if ( bot_status >= '0' && bot_status <= '9' )
 		{
 			// Bot skill.
-			Info_SetValueForKey( buf, "ping", va( "sk%c", bot_status ), false );
+			row.String( "ping", va( "sk%c", bot_status ) );
 		}
 		else
 		{
 			// Example: “G” is for “Generating navmeshes”.
-			Info_SetValueForKey( buf, "ping", va( "%c", bot_status ), false );
+			row.String( "ping", va( "%c", bot_status ) );
 		}
 
-		Info_SetValueForKey( buf, "weapon", va( "%d", score->weapon ), false );
-		Info_SetValueForKey( buf, "upgrade", va( "%d", score->upgrade ), false );
-		Info_SetValueForKey( buf, "time", va( "%d", score->time ), false );
-		Info_SetValueForKey( buf, "credits", va( "%d", ci->credit ), false );
-		Info_SetValueForKey( buf, "location", CG_ConfigString( CS_LOCATIONS + ci->location ), false );
-
 		switch ( score->team )
 		{
 			case TEAM_ALIENS:
 				rocketInfo.data.playerList[ score->team ][ rocketInfo.data.playerCount[ TEAM_ALIENS ]++ ] = i;
-				Rocket_DSAddRow( "playerList", "aliens", buf );
+				Rocket_DSAddRow( "playerList", "aliens", row );
 				break;
 
 			case TEAM_HUMANS:
 				rocketInfo.data.playerList[ score->team ][ rocketInfo.data.playerIndex[ TEAM_HUMANS ]++ ] = i;
-				Rocket_DSAddRow( "playerList", "humans", buf );
+				Rocket_DSAddRow( "playerList", "humans", row );
 				break;
 
 			case TEAM_NONE:
 				rocketInfo.data.playerList[ score->team ][ rocketInfo.data.playerCount[ TEAM_NONE ]++ ] = i;
-				Rocket_DSAddRow( "playerList", "spectators", buf );
+				Rocket_DSAddRow( "playerList", "spectators", row );
 				break;
 		}
 	}
@@ -1026,7 +1007,6 @@ static void CG_Rocket_SortPlayerList( const char*, const char *sortBy )
 	int i;
 	clientInfo_t *ci;
 	score_t *score;
-	char buf[ MAX_INFO_STRING ];
 
 	// Do not sort list if not currently playing
 	if ( rocketInfo.cstate.connState < connstate_t::CA_ACTIVE )
@@ -1058,16 +1038,7 @@ static void CG_Rocket_SortPlayerList( const char*, const char *sortBy )
 			continue;
 		}
 
-		Info_SetValueForKey( buf, "num", va( "%d", score->client ), false );
-		Info_SetValueForKey( buf, "score", va( "%d", score->score ), false );
-		Info_SetValueForKey( buf, "ping", va( "%d", score->ping ), false );
-		Info_SetValueForKey( buf, "weapon", va( "%d", score->weapon ), false );
-		Info_SetValueForKey( buf, "upgrade", va( "%d", score->upgrade ), false );
-		Info_SetValueForKey( buf, "time", va( "%d", score->time ), false );
-		Info_SetValueForKey( buf, "credits", va( "%d", ci->credit ), false );
-		Info_SetValueForKey( buf, "location", CG_ConfigString( CS_LOCATIONS + ci->location ), false );
-
-		Rocket_DSAddRow( "playerList", "spectators", buf );
+		Rocket_DSAddRow( "playerList", "spectators", PlayerRow( score, ci ).Int( "ping", score->ping ) );
 	}
 
 	for ( i = 0; i < rocketInfo.data.playerIndex[ TEAM_HUMANS ]; ++i )
@@ -1080,15 +1051,7 @@ static void CG_Rocket_SortPlayerList( const char*, const char *sortBy )
 			continue;
 		}
 
-		Info_SetValueForKey( buf, "num", va( "%d", score->client ), false );
-		Info_SetValueForKey( buf, "score", va( "%d", score->score ), false );
-		Info_SetValueForKey( buf, "ping", va( "%d", score->ping ), false );
-		Info_SetValueForKey( buf, "weapon", va( "%d", score->weapon ), false );
-		Info_SetValueForKey( buf, "upgrade", va( "%d", score->upgrade ), false );
-		Info_SetValueForKey( buf, "time", va( "%d", score->time ), false );
-		Info_SetValueForKey( buf, "credits", va( "%d", ci->credit ), false );
-		Info_SetValueForKey( buf, "location", CG_ConfigString( CS_LOCATIONS + ci->location ), false );
-		Rocket_DSAddRow( "playerList", "humans", buf );
+		Rocket_DSAddRow( "playerList", "humans", PlayerRow( score, ci ).Int( "ping", score->ping ) );
 	}
 
 	for ( i = 0; i < rocketInfo.data.playerCount[ TEAM_ALIENS ]; ++i )
@@ -1101,16 +1064,7 @@ static void CG_Rocket_SortPlayerList( const char*, const char *sortBy )
 			continue;
 		}
 
-		Info_SetValueForKey( buf, "num", va( "%d", score->client ), false );
-		Info_SetValueForKey( buf, "score", va( "%d", score->score ), false );
-		Info_SetValueForKey( buf, "ping", va( "%d", score->ping ), false );
-		Info_SetValueForKey( buf, "weapon", va( "%d", score->weapon ), false );
-		Info_SetValueForKey( buf, "upgrade", va( "%d", score->upgrade ), false );
-		Info_SetValueForKey( buf, "time", va( "%d", score->time ), false );
-		Info_SetValueForKey( buf, "credits", va( "%d", ci->credit ), false );
-		Info_SetValueForKey( buf, "location", CG_ConfigString( CS_LOCATIONS + ci->location ), false );
-
-		Rocket_DSAddRow( "playerList", "aliens", buf );
+		Rocket_DSAddRow( "playerList", "aliens", PlayerRow( score, ci ).Int( "ping", score->ping ) );
 	}
 }
 
@@ -1393,25 +1347,20 @@ static const char* WeaponRateOfFire( weapon_t weapon )
 
 static void AddWeaponToBuyList( int i, const char *table, int tblIndex )
 {
-	static char buf[ MAX_STRING_CHARS ];
-
-	buf[ 0 ] = '\0';
-
 	if ( BG_Weapon( i )->team == TEAM_HUMANS && BG_Weapon( i )->purchasable &&
 	        i != WP_BLASTER )
 	{
-		Info_SetValueForKey( buf, "num", va( "%d", i ), false );
-		Info_SetValueForKey( buf, "name", BG_Weapon( i )->humanName, false );
-		Info_SetValueForKey( buf, "price", va( "%d", BG_Weapon( i )->price ), false );
-		Info_SetValueForKey( buf, "description", BG_Weapon( i )->info, false );
-		Info_SetValueForKey( buf, "icon", CG_GetShaderNameFromHandle( cg_weapons[ i ].ammoIcon ), false );
-		Info_SetValueForKey( buf, "availability", WeaponAvailability( i ).c_str(), false );
-		Info_SetValueForKey( buf, "cmdName", BG_Weapon( i )->name, false );
-		Info_SetValueForKey( buf, "damage", WeaponDamage( weapon_t(i) ), false );
-		Info_SetValueForKey( buf, "rate", WeaponRateOfFire( weapon_t(i) ), false );
-		Info_SetValueForKey( buf, "range", WeaponRange( weapon_t(i) ), false );
-
-		Rocket_DSAddRow( "armouryBuyList", table, buf );
+		Rocket_DSAddRow( "armouryBuyList", table, RocketDataRow()
+			.Int( "num", i )
+			.String( "name", BG_Weapon( i )->humanName )
+			.Int( "price", BG_Weapon( i )->price )
+			.String( "description", BG_Weapon( i )->info )
+			.String( "icon", CG_GetShaderNameFromHandle( cg_weapons[ i ].ammoIcon ) )
+			.String( "availability", WeaponAvailability( i ) )
+			.String( "cmdName", BG_Weapon( i )->name )
+			.String( "damage", WeaponDamage( weapon_t(i) ) )
+			.String( "rate", WeaponRateOfFire( weapon_t(i) ) )
+			.String( "range", WeaponRange( weapon_t(i) ) ) );
 
 		rocketInfo.data.armouryBuyList[ tblIndex ][ rocketInfo.data.armouryBuyListCount[ tblIndex ]++ ] = i;
 	}
@@ -1453,28 +1402,22 @@ static Str::StringRef UpgradeAvailability( upgrade_t upgrade )
 
 static void AddUpgradeToBuyList( int i, const char *table, int tblIndex )
 {
-	static char buf[ MAX_STRING_CHARS ];
-
 	if ( rocketInfo.cstate.connState < connstate_t::CA_ACTIVE )
 	{
 		return;
 	}
 
-
-	buf[ 0 ] = '\0';
-
 	if ( BG_Upgrade( i )->team == TEAM_HUMANS && BG_Upgrade( i )->purchasable &&
 	        i != UP_MEDKIT )
 	{
-		Info_SetValueForKey( buf, "num", va( "%d", i ), false );
-		Info_SetValueForKey( buf, "name", BG_Upgrade( i )->humanName, false );
-		Info_SetValueForKey( buf, "price", va( "%d", BG_Upgrade( i )->price ), false );
-		Info_SetValueForKey( buf, "description", BG_Upgrade( i )->info, false );
-		Info_SetValueForKey( buf, "availability", UpgradeAvailability( upgrade_t(i) ).c_str(), false );
-		Info_SetValueForKey( buf, "cmdName", BG_Upgrade( i )->name, false );
-		Info_SetValueForKey( buf, "icon", CG_GetShaderNameFromHandle( cg_upgrades[ i ].upgradeIcon ), false );
-
-		Rocket_DSAddRow( "armouryBuyList", table, buf );
+		Rocket_DSAddRow( "armouryBuyList", table, RocketDataRow()
+			.Int( "num", i )
+			.String( "name", BG_Upgrade( i )->humanName )
+			.Int( "price", BG_Upgrade( i )->price )
+			.String( "description", BG_Upgrade( i )->info )
+			.String( "availability", UpgradeAvailability( upgrade_t(i) ) )
+			.String( "cmdName", BG_Upgrade( i )->name )
+			.String( "icon", CG_GetShaderNameFromHandle( cg_upgrades[ i ].upgradeIcon ) ) );
 
 		rocketInfo.data.armouryBuyList[ tblIndex ][ rocketInfo.data.armouryBuyListCount[ tblIndex ]++ ] = i + WP_NUM_WEAPONS;
 
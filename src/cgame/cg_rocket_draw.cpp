@@ -43,6 +43,8 @@ Maryland 20850 USA.
 
 Cvar::Cvar<bool> cg_drawPosition("cg_drawPosition", "show position. Requires cg_drawSpeed to be enabled.", Cvar::NONE, false);
 
+static Log::Logger hudLogger("cgame.hud");
+
 static void CG_GetRocketElementColor( Color::Color& color )
 {
 	Rocket_GetProperty( "color", &color, sizeof(Color::Color), rocketVarType_t::ROCKET_COLOR );
@@ -231,6 +233,39 @@ class TranslateNodeHandler : public Rml::XMLNodeHandler
 	bool ElementEnd(Rml::XMLParser*, const Rml::String& data) override { return true; }
 };
 
+/*
+ * The value a HUD element displays, remembered so that the document is only
+ * changed when the value does. Every change makes RmlUi parse, style and lay
+ * out the element again, and the HUD is updated every frame.
+ */
+template<typename T>
+class HudValue
+{
+public:
+	// Returns whether value differs from the displayed one, and remembers it
+	bool Changed( const T& value )
+	{
+		if ( valid_ && value_ == value )
+		{
+			return false;
+		}
+
+		value_ = value;
+		valid_ = true;
+		return true;
+	}
+
+	// Forget the displayed value, for when the element was changed otherwise
+	void Reset()
+	{
+		valid_ = false;
+	}
+
+private:
+	T value_{};
+	bool valid_ = false;
+};
+
 class HudElement : public Rml::Element
 {
 public:
@@ -330,11 +365,32 @@ public:
 	}
 
 protected:
+	// SetInnerRML and SetProperty that leave the document alone if nothing changed
+	void UpdateInnerRML( const Rml::String& rml )
+	{
+		if ( innerRML_.Changed( rml ) )
+		{
+			hudLogger.Debug( "%s: inner RML changed", GetTagName() );
+			SetInnerRML( rml );
+		}
+	}
+
+	void UpdateProperty( const Rml::String& name, const Rml::String& value )
+	{
+		if ( properties_[ name ].Changed( value ) )
+		{
+			hudLogger.Debug( "%s: %s changed", GetTagName(), name );
+			SetProperty( name, value );
+		}
+	}
+
 	Rml::Vector2f dimensions;
 
 private:
 	rocketElementType_t type;
 	bool isReplacedElement;
+	HudValue<Rml::String> innerRML_;
+	std::unordered_map<Rml::String, HudValue<Rml::String>> properties_;
 };
 
 class TextHudElement : public HudElement
@@ -354,7 +410,11 @@ public:
 
 	void SetText(const Rml::String& text )
 	{
-		textElement->SetText( text );
+		if ( text_.Changed( text ) )
+		{
+			hudLogger.Debug( "%s: text changed", GetTagName() );
+			textElement->SetText( text );
+		}
 	}
 
 private:
@@ -368,7 +428,7 @@ private:
 	}
 
 	Rml::ElementText* textElement;
-
+	HudValue<Rml::String> text_;
 };
 
 class AmmoHudElement : public TextHudElement
@@ -487,34 +547,29 @@ class ClipsHudElement : public TextHudElement
 {
 public:
 	ClipsHudElement( const Rml::String& tag ) :
-		TextHudElement( tag, ELEMENT_HUMANS ),
-		clips_( 0 ) {}
+		TextHudElement( tag, ELEMENT_HUMANS ) {}
 
 	void DoOnUpdate() override
 	{
-		int           value;
 		playerState_t *ps = &cg.snap->ps;
 
 		if ( BG_Weapon( BG_PrimaryWeapon( ps->stats ) )->infiniteAmmo )
 		{
-			if ( clips_ != -1 )
+			if ( clips_.Changed( -1 ) )
 			{
 				SetText( "" );
 			}
-			clips_ = -1;
 			return;
 		}
-		value = ps->clips;
 
-		if ( value > -1 && value != clips_ )
+		if ( ps->clips > -1 && clips_.Changed( ps->clips ) )
 		{
-			SetText( va( "%d", value ) );
-			clips_ = value;
+			SetText( va( "%d", ps->clips ) );
 		}
 	}
 
 private:
-	int clips_;
+	HudValue<int> clips_;
 };
 
 
@@ -538,6 +593,7 @@ public:
 		if ( !cg_drawFPS.Get() && shouldShowFps_ )
 		{
 			shouldShowFps_ = false;
+			fps_.Reset();
 			SetText( "" );
 			return;
 		} else if ( !shouldShowFps_ )
@@ -575,10 +631,14 @@ public:
 		else
 			fps = 0;
 
-		SetText( va( "%d", fps ) );
+		if ( fps_.Changed( fps ) )
+		{
+			SetText( va( "%d", fps ) );
+		}
 	}
 private:
 	bool shouldShowFps_;
+	HudValue<int> fps_;
 	int previousTimes_[ FPS_FRAMES ];
 	int index_;
 	int previous_;
@@ -919,6 +979,8 @@ public:
 			{
 				currentSpeedElement->SetText( "" );
 				maxSpeedElement->SetText( "" );
+				currentSpeed_.Reset();
+				maxSpeed_.Reset();
 				shouldDrawSpeed_ = false;
 			}
 			return;
@@ -997,14 +1059,25 @@ public:
 			{
 				val = speedSamples[( oldestSpeedSample - 1 + SPEEDOMETER_NUM_SAMPLES ) % SPEEDOMETER_NUM_SAMPLES ];
 			}
-			maxSpeedElement->SetText( va( "%d ", ( int ) speedSamples[ maxSpeedSampleInWindow ] ) );
-			currentSpeedElement->SetText( va( "%d", ( int ) val ) );
+			int maxSpeed = speedSamples[ maxSpeedSampleInWindow ];
+
+			if ( maxSpeed_.Changed( maxSpeed ) )
+			{
+				maxSpeedElement->SetText( va( "%d ", maxSpeed ) );
+			}
+
+			if ( currentSpeed_.Changed( ( int ) val ) )
+			{
+				currentSpeedElement->SetText( va( "%d", ( int ) val ) );
+			}
 		}
 	}
 
 private:
 	Rml::ElementText* maxSpeedElement;
 	Rml::ElementText* currentSpeedElement;
+	HudValue<int> maxSpeed_;
+	HudValue<int> currentSpeed_;
 	bool shouldDrawSpeed_;
 };
 
@@ -1048,30 +1121,27 @@ class CreditsValueElement : public TextHudElement
 {
 public:
 	CreditsValueElement( const Rml::String& tag ) :
-			TextHudElement( tag, ELEMENT_HUMANS ),
-			credits_( -1 ) {}
+			TextHudElement( tag, ELEMENT_HUMANS ) {}
 
 	void DoOnUpdate() override
 	{
-		playerState_t *ps = &cg.snap->ps;
-		int value = ps->persistant[ PERS_CREDIT ];;
-		if ( credits_ != value )
+		int value = cg.snap->ps.persistant[ PERS_CREDIT ];
+
+		if ( credits_.Changed( value ) )
 		{
-			credits_ = value;
-			SetText( va( "%d", credits_ ) );
+			SetText( va( "%d", value ) );
 		}
 	}
 
 private:
-	int credits_;
+	HudValue<int> credits_;
 };
 
 class EvosValueElement : public TextHudElement
 {
 public:
 	EvosValueElement( const Rml::String& tag ) :
-			TextHudElement( tag, ELEMENT_ALIENS ),
-			evos_( -1 ) {}
+			TextHudElement( tag, ELEMENT_ALIENS ) {}
 
 	void DoOnUpdate() override
 	{
@@ -1087,15 +1157,14 @@ public:
 		// value is in tenth of evo points
 		value = value * 10 / CREDITS_PER_EVO;
 
-		if ( evos_ != value )
+		if ( evos_.Changed( value ) )
 		{
-			evos_ = value;
 			SetText( va( "%i.%i", value/10, value%10 ) );
 		}
 	}
 
 private:
-	int evos_;
+	HudValue<int> evos_;
 };
 
 class WeaponIconElement : public HudElement
@@ -1292,10 +1361,7 @@ class TimerElement : public TextHudElement
 {
 public:
 	TimerElement( const Rml::String& tag ) :
-			TextHudElement( tag, ELEMENT_GAME ),
-			mins_( 0 ),
-			seconds_( 0 ),
-			tens_( 0 ) {}
+			TextHudElement( tag, ELEMENT_GAME ) {}
 
 	void DoOnUpdate() override
 	{
@@ -1314,26 +1380,23 @@ public:
 
 		msec = cg.time - cgs.levelStartTime;
 
+		// only the displayed seconds matter
+		if ( !seconds_.Changed( msec / 1000 ) )
+		{
+			return;
+		}
+
 		seconds = msec / 1000;
 		mins = seconds / 60;
 		seconds -= mins * 60;
 		tens = seconds / 10;
 		seconds -= tens * 10;
 
-		if ( seconds_ != seconds || mins != mins_ || tens != tens_ )
-		{
-			SetText( va( "%d:%d%d", mins, tens, seconds ) );
-			seconds_ = seconds;
-			mins_ = mins;
-			tens_ = tens;
-		}
+		SetText( va( "%d:%d%d", mins, tens, seconds ) );
 	}
 
 private:
-	int mins_;
-	int seconds_;
-	int tens_;
-
+	HudValue<int> seconds_;
 };
 
 #define LAG_SAMPLES 128
@@ -1953,7 +2016,7 @@ public:
 			             Rml::Property( cg.centerPrintSizeFactor, Rml::Property::EM ) );
 		}
 
-		SetProperty( "opacity", va( "%f", CG_FadeAlpha( cg.centerPrintTime, CENTER_PRINT_DURATION ) ) );
+		UpdateProperty( "opacity", va( "%f", CG_FadeAlpha( cg.centerPrintTime, CENTER_PRINT_DURATION ) ) );
 	}
 
 private:
@@ -2369,6 +2432,8 @@ public:
 			{
 				SetInnerRML( "" );
 			}
+
+			barbOpacity_.clear();
 		}
 	}
 
@@ -2412,21 +2477,28 @@ public:
 		}
 		numBarbs_ = newNumBarbs;
 
+		barbOpacity_.resize( GetNumChildren() );
+
 		for ( int i = 0; i < GetNumChildren(); i++ )
 		{
-			Element *barb = GetChild(i);
+			float opacity;
+
 			if (i < numBarbs_ ) // draw existing barbs
 			{
-				barb->SetProperty( "opacity", "1.0" );
+				opacity = 1.0f;
 			}
 			else if (i == numBarbs_ ) // draw regenerating barb
 			{
-				float opacity = GetSin() / 8.0f + ( 1.0f / 8.0f ); // in [0, 0.125]
-				barb->SetProperty( "opacity", va( "%f", opacity ) );
+				opacity = GetSin() / 8.0f + ( 1.0f / 8.0f ); // in [0, 0.125]
 			}
 			else
 			{
-				barb->SetProperty( "opacity", "0.0" );
+				opacity = 0.0f;
+			}
+
+			if ( barbOpacity_[ i ].Changed( opacity ) )
+			{
+				GetChild( i )->SetProperty( "opacity", va( "%f", opacity ) );
 			}
 		}
 	}
@@ -2458,6 +2530,8 @@ private:
 	// t0 and offset are used to make sure that there are no sudden jumps in opacity.
 	int t0_;
 	float offset_;
+
+	std::vector<HudValue<float>> barbOpacity_;
 };
 
 class SpawnQueueElement : public TextHudElement
@@ -2563,19 +2637,35 @@ public:
 
 		team_t team = BG_PlayableTeamFromString( teamname.c_str() );
 
-		SetText( va( "%d", cg.teamPlayerCount[ team ] ) );
+		if ( count_.Changed( cg.teamPlayerCount[ team ] ) )
+		{
+			SetText( va( "%d", cg.teamPlayerCount[ team ] ) );
+		}
 	}
+
+private:
+	HudValue<int> count_;
 };
 
-static void CG_Rocket_DrawPlayerHealth()
+class HealthHudElement : public TextHudElement
 {
-	static int lastHealth = 0;
+public:
+	HealthHudElement( const Rml::String& tag ) :
+			TextHudElement( tag, ELEMENT_BOTH ) {}
 
-	if ( lastHealth != cg.snap->ps.stats[ STAT_HEALTH ] )
+	void DoOnUpdate() override
 	{
-		Rocket_SetInnerRMLRaw( va( "%d", cg.snap->ps.stats[ STAT_HEALTH ] ) );
+		int health = cg.snap->ps.stats[ STAT_HEALTH ];
+
+		if ( health_.Changed( health ) )
+		{
+			SetText( va( "%d", health ) );
+		}
 	}
-}
+
+private:
+	HudValue<int> health_;
+};
 
 static void CG_Rocket_DrawPlayerHealthCross()
 {
@@ -3747,7 +3837,6 @@ static const elementRenderCmd_t elementRenderCmdList[] =
 	{ "downloadTime", &CG_Rocket_DrawDownloadTime, nullptr, ELEMENT_ALL },
 	{ "downloadTotalSize", &CG_Rocket_DrawDownloadTotalSize, nullptr, ELEMENT_ALL },
 	{ "follow", &CG_Rocket_DrawFollow, nullptr, ELEMENT_GAME },
-	{ "health", &CG_Rocket_DrawPlayerHealth, nullptr, ELEMENT_BOTH },
 	{ "health_cross", nullptr, &CG_Rocket_DrawPlayerHealthCross, ELEMENT_BOTH },
 	{ "hostname", &CG_Rocket_DrawHostname, nullptr, ELEMENT_ALL },
 	{ "inventory", &CG_DrawHumanInventory, nullptr, ELEMENT_HUMANS },
@@ -3816,6 +3905,7 @@ void CG_Rocket_RegisterElements()
 	// Game-specific RML
 	RegisterElement<AmmoHudElement>( "ammo" );
 	RegisterElement<ClipsHudElement>( "clips" );
+	RegisterElement<HealthHudElement>( "health" );
 	RegisterElement<FpsHudElement>( "fps" );
 	RegisterElement<CrosshairIndicatorHudElement>( "crosshair_indicator" );
 	RegisterElement<CrosshairHudElement>( "crosshair" );
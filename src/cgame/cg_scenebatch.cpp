@@ -0,0 +1,231 @@
+/*
+===========================================================================
+
+Unvanquished GPL Source Code
+Copyright (C) 2022 Unvanquished Developers
+
+This file is part of the Unvanquished GPL Source Code (Unvanquished Source Code).
+
+Unvanquished is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Unvanquished is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Unvanquished.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+
+// cg_scenebatch.cpp -- batched submission of polys to the renderer
+
+#include "cg_local.h"
+
+static Log::Logger logger("cgame.scenebatch");
+
+/*
+===================================================================
+
+Every scene trap is a round trip to the engine. Polys passed to
+CG_BatchPolys are collected by shader and vertex count instead and
+submitted with one trap_R_AddPolysToScene per batch when the frame
+is complete. Polys keep their order within a batch.
+
+The renderer drops polys beyond r_maxPolys and r_maxPolyVerts in a
+scene, so sprites, which could be refEntities instead, are only
+batched while they fit.
+
+===================================================================
+*/
+
+struct polyBatch_t
+{
+	qhandle_t               shader;
+	int                     numVerts; // per poly
+	std::vector<polyVert_t> verts;
+};
+
+// batches beyond numPolyBatches are unused, but keep their storage
+static std::vector<polyBatch_t> polyBatches;
+static size_t                   numPolyBatches = 0;
+static int                      lastPolyBatch = -1;
+
+// polys and vertices queued this frame, and the renderer's limits (latched, so read once)
+static int                      numBatchedPolys = 0;
+static int                      numBatchedVerts = 0;
+static int                      maxPolys = -1;
+static int                      maxPolyVerts = -1;
+
+/*
+===============
+CG_FindPolyBatch
+===============
+*/
+static polyBatch_t *CG_FindPolyBatch( qhandle_t shader, int numVerts )
+{
+	// consecutive polys usually share a shader
+	if ( lastPolyBatch >= 0 )
+	{
+		polyBatch_t *batch = &polyBatches[ lastPolyBatch ];
+
+		if ( batch->shader == shader && batch->numVerts == numVerts )
+		{
+			return batch;
+		}
+	}
+
+	for ( size_t i = 0; i < numPolyBatches; i++ )
+	{
+		polyBatch_t *batch = &polyBatches[ i ];
+
+		if ( batch->shader == shader && batch->numVerts == numVerts )
+		{
+			lastPolyBatch = i;
+			return batch;
+		}
+	}
+
+	if ( numPolyBatches == polyBatches.size() )
+	{
+		polyBatches.emplace_back();
+	}
+
+	lastPolyBatch = numPolyBatches++;
+
+	polyBatch_t *batch = &polyBatches[ lastPolyBatch ];
+	batch->shader = shader;
+	batch->numVerts = numVerts;
+	batch->verts.clear();
+
+	return batch;
+}
+
+/*
+===============
+CG_BatchPolys
+
+Queue numPolys polys of numVerts vertices each
+===============
+*/
+void CG_BatchPolys( qhandle_t shader, int numVerts, const polyVert_t *verts, int numPolys )
+{
+	if ( numVerts <= 0 || numPolys <= 0 )
+	{
+		return;
+	}
+
+	polyBatch_t *batch = CG_FindPolyBatch( shader, numVerts );
+
+	batch->verts.insert( batch->verts.end(), verts, verts + numVerts * numPolys );
+
+	numBatchedPolys += numPolys;
+	numBatchedVerts += numVerts * numPolys;
+}
+
+/*
+===============
+CG_BatchSprite
+
+Queue a camera facing quad, built like the renderer builds RT_SPRITE entities.
+Returns false if it doesn't fit in the renderer's poly limits, the caller
+should add it as a refEntity then.
+===============
+*/
+bool CG_BatchSprite( qhandle_t shader, const vec3_t origin, float radius, float rotation, const byte color[ 4 ] )
+{
+	vec3_t left, up;
+
+	if ( maxPolys < 0 )
+	{
+		maxPolys = trap_Cvar_VariableIntegerValue( "r_maxPolys" );
+		maxPolyVerts = trap_Cvar_VariableIntegerValue( "r_maxPolyVerts" );
+	}
+
+	if ( numBatchedPolys + 1 > maxPolys || numBatchedVerts + 4 > maxPolyVerts )
+	{
+		return false;
+	}
+
+	if ( rotation == 0.0f )
+	{
+		VectorScale( cg.refdef.viewaxis[ 1 ], radius, left );
+		VectorScale( cg.refdef.viewaxis[ 2 ], radius, up );
+	}
+	else
+	{
+		float angle = DEG2RAD( rotation );
+		float s = sinf( angle );
+		float c = cosf( angle );
+
+		VectorScale( cg.refdef.viewaxis[ 1 ], c * radius, left );
+		VectorMA( left, -s * radius, cg.refdef.viewaxis[ 2 ], left );
+
+		VectorScale( cg.refdef.viewaxis[ 2 ], c * radius, up );
+		VectorMA( up, s * radius, cg.refdef.viewaxis[ 1 ], up );
+	}
+
+	polyVert_t verts[ 4 ];
+
+	VectorAdd( origin, left, verts[ 0 ].xyz );
+	VectorAdd( verts[ 0 ].xyz, up, verts[ 0 ].xyz );
+	verts[ 0 ].st[ 0 ] = 0.0f;
+	verts[ 0 ].st[ 1 ] = 0.0f;
+
+	VectorSubtract( origin, left, verts[ 1 ].xyz );
+	VectorAdd( verts[ 1 ].xyz, up, verts[ 1 ].xyz );
+	verts[ 1 ].st[ 0 ] = 1.0f;
+	verts[ 1 ].st[ 1 ] = 0.0f;
+
+	VectorSubtract( origin, left, verts[ 2 ].xyz );
+	VectorSubtract( verts[ 2 ].xyz, up, verts[ 2 ].xyz );
+	verts[ 2 ].st[ 0 ] = 1.0f;
+	verts[ 2 ].st[ 1 ] = 1.0f;
+
+	VectorAdd( origin, left, verts[ 3 ].xyz );
+	VectorSubtract( verts[ 3 ].xyz, up, verts[ 3 ].xyz );
+	verts[ 3 ].st[ 0 ] = 0.0f;
+	verts[ 3 ].st[ 1 ] = 1.0f;
+
+	for ( polyVert_t &vert : verts )
+	{
+		memcpy( vert.modulate, color, sizeof( vert.modulate ) );
+	}
+
+	CG_BatchPolys( shader, 4, verts, 1 );
+	return true;
+}
+
+/*
+===============
+CG_FlushSceneBatches
+
+Submit everything queued this frame, has to happen before the scene is rendered
+===============
+*/
+void CG_FlushSceneBatches()
+{
+	int numPolys = 0;
+
+	for ( size_t i = 0; i < numPolyBatches; i++ )
+	{
+		polyBatch_t *batch = &polyBatches[ i ];
+		int batchPolys = batch->verts.size() / batch->numVerts;
+
+		trap_R_AddPolysToScene( batch->shader, batch->numVerts, batch->verts.data(), batchPolys );
+
+		numPolys += batchPolys;
+		batch->verts.clear();
+	}
+
+	logger.Debug( "%d polys in %d submissions", numPolys, numPolyBatches );
+
+	numPolyBatches = 0;
+	lastPolyBatch = -1;
+	numBatchedPolys = 0;
+	numBatchedVerts = 0;
+}
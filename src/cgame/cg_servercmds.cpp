@@ -83,6 +83,7 @@ static void CG_ParseScores()
 =================
 CG_ParseTeamInfo
 
+Every entry only carries the fields that changed, see teamInfoField_t
 =================
 */
 static void CG_ParseTeamInfo()
@@ -90,13 +91,15 @@ static void CG_ParseTeamInfo()
 	int i;
 	int count;
 	int client;
+	int mask;
 
 	count = trap_Argc();
 
 	team_t myteam = static_cast<team_t>( cg.snap->ps.persistant[ PERS_TEAM ] );
-	for ( i = 1; i < count; ++i ) // i is also incremented when writing into cgs.clientinfo
+	for ( i = 1; i + 1 < count; ++i ) // i is also incremented when writing into cgs.clientinfo
 	{
 		client = atoi( CG_Argv( i ) );
+		mask = strtol( CG_Argv( ++i ), nullptr, 16 );
 
 		if ( client < 0 || client >= MAX_CLIENTS )
 		{
@@ -104,20 +107,45 @@ static void CG_ParseTeamInfo()
 			return;
 		}
 
-		// wrong team? skip to the next one
-		if ( cgs.clientinfo[ client ].team != myteam )
+		clientInfo_t *ci = &cgs.clientinfo[ client ];
+
+		// wrong team? skip the fields of this one
+		if ( ci->team != myteam )
 		{
-			return;
+			for ( int field = TEAMINFO_LOCATION; field & TEAMINFO_ALL; field <<= 1 )
+			{
+				if ( mask & field )
+				{
+					++i;
+				}
+			}
+
+			continue;
+		}
+
+		if ( mask & TEAMINFO_LOCATION )
+		{
+			ci->location = atoi( CG_Argv( ++i ) );
 		}
 
-		cgs.clientinfo[ client ].location       = atoi( CG_Argv( ++i ) );
-		cgs.clientinfo[ client ].health         = atoi( CG_Argv( ++i ) );
-		cgs.clientinfo[ client ].curWeaponClass = atoi( CG_Argv( ++i ) );
-		cgs.clientinfo[ client ].credit         = atoi( CG_Argv( ++i ) );
+		if ( mask & TEAMINFO_HEALTH )
+		{
+			ci->health = atoi( CG_Argv( ++i ) );
+		}
+
+		if ( mask & TEAMINFO_WEAPONCLASS )
+		{
+			ci->curWeaponClass = atoi( CG_Argv( ++i ) );
+		}
+
+		if ( mask & TEAMINFO_CREDIT )
+		{
+			ci->credit = atoi( CG_Argv( ++i ) );
+		}
 
-		if( myteam != TEAM_ALIENS )
+		if ( mask & TEAMINFO_UPGRADE )
 		{
-			cgs.clientinfo[ client ].upgrade = atoi( CG_Argv( ++i ) );
+			ci->upgrade = atoi( CG_Argv( ++i ) );
 		}
 	}
 
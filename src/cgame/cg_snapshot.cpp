@@ -29,6 +29,75 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include "cg_local.h"
 
+/*
+The entities of the current snapshot by type, players and buildables also by
+team, so that code looking for a few types doesn't have to walk all entities.
+Freestanding events are all listed as ET_EVENTS.
+*/
+static const int NUM_ENTITY_LISTS = Util::ordinal( entityType_t::ET_EVENTS ) + 1;
+
+static centityList_t cg_entitiesOfType[ NUM_ENTITY_LISTS ];
+static centityList_t cg_playersOfTeam[ NUM_TEAMS ];
+static centityList_t cg_buildablesOfTeam[ NUM_TEAMS ];
+
+/*
+==================
+CG_BuildEntityLists
+==================
+*/
+static void CG_BuildEntityLists()
+{
+	for ( centityList_t &list : cg_entitiesOfType )
+	{
+		list.clear();
+	}
+
+	for ( int team = TEAM_NONE; team < NUM_TEAMS; team++ )
+	{
+		cg_playersOfTeam[ team ].clear();
+		cg_buildablesOfTeam[ team ].clear();
+	}
+
+	for ( const entityState_t &es : cg.snap->entities )
+	{
+		centity_t *cent = &cg_entities[ es.number ];
+		int       type = std::min( Util::ordinal( es.eType ), NUM_ENTITY_LISTS - 1 );
+
+		cg_entitiesOfType[ type ].append( cent );
+
+		team_t team = CG_Team( es );
+
+		if ( team < TEAM_NONE || team >= NUM_TEAMS )
+		{
+			continue;
+		}
+
+		if ( es.eType == entityType_t::ET_PLAYER )
+		{
+			cg_playersOfTeam[ team ].append( cent );
+		}
+		else if ( es.eType == entityType_t::ET_BUILDABLE )
+		{
+			cg_buildablesOfTeam[ team ].append( cent );
+		}
+	}
+}
+
+const centityList_t &CG_EntitiesOfType( entityType_t type )
+{
+	return cg_entitiesOfType[ std::min( Util::ordinal( type ), NUM_ENTITY_LISTS - 1 ) ];
+}
+
+const centityList_t &CG_PlayersOfTeam( team_t team )
+{
+	return cg_playersOfTeam[ team ];
+}
+
+const centityList_t &CG_BuildablesOfTeam( team_t team )
+{
+	return cg_buildablesOfTeam[ team ];
+}
+
 /*
 ==================
 CG_ResetEntity
@@ -94,6 +163,8 @@ static void CG_SetInitialSnapshot( snapshot_t *snap )
 
 	cg.snap = snap;
 
+	CG_BuildEntityLists();
+
 	BG_PlayerStateToEntityState( &snap->ps, &cg_entities[ snap->ps.clientNum ].currentState, false );
 
 	// sort out solid entities
@@ -169,6 +240,8 @@ static void CG_TransitionSnapshot()
 	oldFrame = cg.snap;
 	cg.snap = cg.nextSnap;
 
+	CG_BuildEntityLists();
+
 	// Need to store the previous weapon because BG_PlayerStateToEntityState might change it
 	// so the CG_OnPlayerWeaponChange callback is never called
 	oldWeapon = oldFrame->ps.weapon;
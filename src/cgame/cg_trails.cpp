@@ -302,7 +302,7 @@ static void CG_RenderBeam( trailBeam_t *tb )
 	}
 	while ( i );
 
-	trap_R_AddPolysToScene( tb->class_->shader, 4, &verts[ 0 ], numVerts / 4 );
+	CG_BatchPolys( tb->class_->shader, 4, &verts[ 0 ], numVerts / 4 );
 }
 
 /*
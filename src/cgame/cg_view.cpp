@@ -1962,6 +1962,9 @@ void CG_DrawActiveFrame( int serverTime, bool demoPlayback )
 	cg.oldTime = cg.time;
 	CG_AddLagometerFrameInfo();
 
+	// submit the polys batched by marks, particles and trails
+	CG_FlushSceneBatches();
+
 	// actually issue the rendering calls
 	CG_DrawActive();
 }
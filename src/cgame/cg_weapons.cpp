@@ -1063,7 +1063,7 @@ static void CG_SetWeaponLerpFrameAnimation( weapon_t weapon, lerpFrame_t *lf, in
 
 	if ( /*&cg_weapons[ weapon ].md5 &&*/ !toggle && lf->old_animation && lf->old_animation->handle )
 	{
-		if ( !trap_R_BuildSkeleton( &oldGunSkeleton, lf->old_animation->handle, lf->oldFrame, lf->frame, lf->backlerp, lf->old_animation->clearOrigin ) )
+		if ( !CG_BuildSkeleton( &oldGunSkeleton, lf->old_animation->handle, lf->oldFrame, lf->frame, lf->backlerp, lf->old_animation->clearOrigin ) )
 		{
 			Log::Warn( "CG_SetWeaponLerpFrameAnimation: can't build old gunSkeleton" );
 			return;
@@ -1160,7 +1160,7 @@ CG_CalculateWeaponPosition
 static void CG_CalculateWeaponPosition( vec3_t out_origin, vec3_t out_angles )
 {
 	//weaponInfo_t *weapon = cg_weapons + cg.predictedPlayerState.weapon;
-	Filter<WeaponOffsets> &filter = cg.weaponOffsetsFilter;
+	auto &filter = cg.weaponOffsetsFilter;
 
 	filter.SetWidth( 350 );
 
@@ -45,21 +45,17 @@ class RocketDataFormatter : public Rml::DataFormatter
 public:
 	Rml::String name;
 	int handle;
-	char data[ BIG_INFO_STRING ];
+	const Rml::StringList *data;
 	Rml::String out;
 
-	RocketDataFormatter( const char *name, int handle ) : Rml::DataFormatter( name ), name( name ), handle( handle ) { }
+	RocketDataFormatter( const char *name, int handle ) : Rml::DataFormatter( name ), name( name ), handle( handle ), data( nullptr ) { }
 	~RocketDataFormatter() { }
 
 	void FormatData( Rml::String &formatted_data, const Rml::StringList &raw_data )
 	{
-		memset( &data, 0, sizeof( data ) );
-
-		for ( size_t i = 0; i < raw_data.size(); ++i )
-		{
-			Info_SetValueForKeyRocket( data, va( "%u", ( uint32_t ) i+1 ), raw_data[ i ].c_str(), true );
-		}
+		data = &raw_data;
 		CG_Rocket_FormatData(handle);
+		data = nullptr;
 		formatted_data = out;
 	}
 };
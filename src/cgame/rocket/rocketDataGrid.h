@@ -40,6 +40,11 @@ Maryland 20850 USA.
 #include <RmlUi/Core.h>
 #include <RmlUi/Core/Elements/DataSource.h>
 
+/*
+ * Tables are stored by column with typed values, so that rows don't have to
+ * be serialized into info strings and parsed again for every column that is
+ * read. Rows are identified by their index, which AddRow returns.
+ */
 class RocketDataGrid : public Rml::DataSource
 {
 public:
@@ -47,49 +52,214 @@ public:
 	~RocketDataGrid() { }
 	void GetRow( Rml::StringList& row, const Rml::String& table, int row_index, const Rml::StringList& columns )
 	{
-		if ( data.find( table ) == data.end() || data[table].size() <= (unsigned) row_index )
+		auto it = tables.find( table );
+
+		if ( it == tables.end() || it->second.numRows <= (unsigned) row_index )
 		{
 			return;
 		}
 
+		const table_t &data = it->second;
+
 		for ( auto &&column : columns )
 		{
-			row.emplace_back( Rocket_QuakeToRML( Info_ValueForKey( data[ table ][ row_index ].c_str(), column.c_str() ), RP_EMOTICONS ) );
+			auto index = data.columnIndex.find( column );
+
+			if ( index == data.columnIndex.end() )
+			{
+				row.emplace_back();
+				continue;
+			}
+
+			const rocketDataValue_t &cell = data.columns[ index->second ][ row_index ];
+
+			switch ( cell.type )
+			{
+				case rocketVarType_t::ROCKET_INT:
+					row.emplace_back( std::to_string( cell.intValue ) );
+					break;
+
+				case rocketVarType_t::ROCKET_FLOAT:
+					row.emplace_back( Str::Format( "%g", cell.floatValue ) );
+					break;
+
+				default:
+					row.emplace_back( Rocket_QuakeToRML( cell.stringValue.c_str(), RP_EMOTICONS ) );
+					break;
+			}
 		}
 	}
 
 	int GetNumRows( const Rml::String& table )
 	{
-		return data[ table ].size();
+		auto it = tables.find( table );
+		return it == tables.end() ? 0 : it->second.numRows;
 	}
 
-	void AddRow( const char *table, const char *dataIn )
+	int AddRow( const char *table, const char *dataIn )
 	{
-		data[ table ].push_back( dataIn );
-		NotifyRowAdd( table, data[ table ].size() - 1, 1 );
+		table_t &data = tables[ table ];
+		int row = AddEmptyRow( data );
+
+		SetInfoString( data, row, dataIn );
+		NotifyRowAdd( table, row, 1 );
+		return row;
+	}
+
+	int AddRow( const char *table, const RocketDataRow &dataIn )
+	{
+		table_t &data = tables[ table ];
+		int row = AddEmptyRow( data );
+
+		SetValues( data, row, dataIn );
+		NotifyRowAdd( table, row, 1 );
+		return row;
+	}
+
+	// Inserts a row before the given one, or appends it if row is the number of rows
+	void InsertRow( const char *table, const int row, const RocketDataRow &dataIn )
+	{
+		table_t &data = tables[ table ];
+
+		if ( row < 0 || (unsigned) row > data.numRows )
+		{
+			return;
+		}
+
+		for ( auto &column : data.columns )
+		{
+			column.emplace( column.begin() + row );
+		}
+
+		data.numRows++;
+		SetValues( data, row, dataIn );
+		NotifyRowAdd( table, row, 1 );
 	}
 
 	void ChangeRow( const char *table, const int row, const char *dataIn )
 	{
-		data[ table ][ row ] = dataIn;
+		table_t &data = tables[ table ];
+
+		if ( !ValidRow( data, row ) )
+		{
+			return;
+		}
+
+		ClearRow( data, row );
+		SetInfoString( data, row, dataIn );
+		NotifyRowChange( table, row, 1 );
+	}
+
+	void ChangeRow( const char *table, const int row, const RocketDataRow &dataIn )
+	{
+		table_t &data = tables[ table ];
+
+		if ( !ValidRow( data, row ) )
+		{
+			return;
+		}
+
+		ClearRow( data, row );
+		SetValues( data, row, dataIn );
 		NotifyRowChange( table, row, 1 );
 	}
 
 	void RemoveRow( const char *table, const int row )
 	{
-		data[ table ].erase( data[ table ].begin() + row - 1 );
+		table_t &data = tables[ table ];
+
+		if ( !ValidRow( data, row ) )
+		{
+			return;
+		}
+
+		for ( auto &column : data.columns )
+		{
+			column.erase( column.begin() + row );
+		}
+
+		data.numRows--;
 		NotifyRowRemove( table, row, 1 );
 	}
 
 	void ClearTable( const char *table )
 	{
-		data.erase( table );
+		tables.erase( table );
 		NotifyRowChange( table );
 	}
 
 
 private:
-	std::map<Rml::String, std::vector<Rml::String> > data;
+	struct table_t
+	{
+		std::unordered_map<Rml::String, size_t>      columnIndex;
+		std::vector<std::vector<rocketDataValue_t> > columns;
+		size_t                                       numRows = 0;
+	};
+
+	static bool ValidRow( const table_t &data, int row )
+	{
+		return row >= 0 && (unsigned) row < data.numRows;
+	}
+
+	static int AddEmptyRow( table_t &data )
+	{
+		for ( auto &column : data.columns )
+		{
+			column.emplace_back();
+		}
+
+		return data.numRows++;
+	}
+
+	static void ClearRow( table_t &data, int row )
+	{
+		for ( auto &column : data.columns )
+		{
+			column[ row ] = rocketDataValue_t();
+		}
+	}
+
+	static rocketDataValue_t &Cell( table_t &data, int row, const char *column )
+	{
+		auto it = data.columnIndex.find( column );
+
+		if ( it == data.columnIndex.end() )
+		{
+			it = data.columnIndex.emplace( column, data.columns.size() ).first;
+			data.columns.emplace_back( data.numRows );
+		}
+
+		return data.columns[ it->second ][ row ];
+	}
+
+	static void SetValues( table_t &data, int row, const RocketDataRow &dataIn )
+	{
+		for ( const auto &value : dataIn.Values() )
+		{
+			Cell( data, row, value.first ) = value.second;
+		}
+	}
+
+	// Stores the values of an info string as string columns
+	static void SetInfoString( table_t &data, int row, const char *info )
+	{
+		static char key[ BIG_INFO_VALUE ], value[ BIG_INFO_VALUE ];
+
+		while ( *info )
+		{
+			Info_NextPair( &info, key, value );
+
+			if ( !key[ 0 ] )
+			{
+				break;
+			}
+
+			Cell( data, row, key ).stringValue = value;
+		}
+	}
+
+	std::unordered_map<Rml::String, table_t> tables;
 };
 
 #endif
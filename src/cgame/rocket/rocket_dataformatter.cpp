@@ -46,10 +46,10 @@ void Rocket_RegisterDataFormatter( const char *name )
 	dataFormatterList.push_back( new RocketDataFormatter( name, dataFormatterList.size() ) );
 }
 
-void Rocket_DataFormatterRawData( int handle, char *name, int nameLength, char *data, int dataLength )
+const char *Rocket_DataFormatterRawData( int handle, const std::vector<std::string> **data )
 {
-	Q_strncpyz( name, dataFormatterList[ handle ]->name.c_str(), nameLength );
-	Q_strncpyz( data, dataFormatterList[ handle ]->data, dataLength );
+	*data = dataFormatterList[ handle ]->data;
+	return dataFormatterList[ handle ]->name.c_str();
 }
 
 void Rocket_DataFormatterFormattedData( int handle, const char *data, bool parseQuake )
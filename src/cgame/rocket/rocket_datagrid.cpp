@@ -61,17 +61,30 @@ static RocketDataGrid *FindDataSource( const char *name )
 	return it->second;
 }
 
-void Rocket_DSAddRow( const char *name, const char *table, const char *data )
+int Rocket_DSAddRow( const char *name, const char *table, const char *data )
 {
 	RocketDataGrid *ds = FindDataSource( name );
 
 	if ( !ds )
 	{
 		Log::Warn( "Rocket_DSAddRow: data source %s does not exist.", name );
-		return;
+		return -1;
 	}
 
-	ds->AddRow( table, data );
+	return ds->AddRow( table, data );
+}
+
+int Rocket_DSAddRow( const char *name, const char *table, const RocketDataRow &data )
+{
+	RocketDataGrid *ds = FindDataSource( name );
+
+	if ( !ds )
+	{
+		Log::Warn( "Rocket_DSAddRow: data source %s does not exist.", name );
+		return -1;
+	}
+
+	return ds->AddRow( table, data );
 }
 
 void Rocket_DSChangeRow( const char *name, const char *table, const int row, const char *data )
@@ -87,6 +100,32 @@ void Rocket_DSChangeRow( const char *name, const char *table, const int row, con
 	ds->ChangeRow( table, row, data );
 }
 
+void Rocket_DSChangeRow( const char *name, const char *table, const int row, const RocketDataRow &data )
+{
+	RocketDataGrid *ds = FindDataSource( name );
+
+	if ( !ds )
+	{
+		Log::Warn( "Rocket_DSChangeRow: data source %s does not exist.", name );
+		return;
+	}
+
+	ds->ChangeRow( table, row, data );
+}
+
+void Rocket_DSInsertRow( const char *name, const char *table, const int row, const RocketDataRow &data )
+{
+	RocketDataGrid *ds = FindDataSource( name );
+
+	if ( !ds )
+	{
+		Log::Warn( "Rocket_DSInsertRow: data source %s does not exist.", name );
+		return;
+	}
+
+	ds->InsertRow( table, row, data );
+}
+
 void Rocket_DSRemoveRow( const char *name, const char *table, const int row )
 {
 	RocketDataGrid *ds = FindDataSource( name );
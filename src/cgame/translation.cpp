@@ -39,15 +39,57 @@ Maryland 20850 USA.
 #include "tinygettext/log.hpp"
 #include "tinygettext/tinygettext.hpp"
 #include "tinygettext/file_system.hpp"
+#include "tinygettext/plural_forms.hpp"
 
+#include "common/FileSystem.h"
 #include "cg_local.h"
 
 static Log::Logger LOG(VM_STRING_PREFIX "translation");
 using namespace tinygettext;
 
-// Ugly char buffer
-static std::string gettextbuffer[ 4 ];
-static int num = -1;
+/*
+ * Every distinct translated string is kept until the language changes, so the
+ * pointers returned by the Trans_ functions stay valid until then.
+ *
+ * Most callers ask for the same strings every frame, so results are cached by
+ * the contents of the arguments. Entries are found by a hash of the contents,
+ * so a lookup doesn't have to copy them, and the same text in another buffer
+ * shares its entry.
+ *
+ * Those callers mostly pass the same pointers every frame as well, usually to
+ * string literals, so the entry last found for a msgid pointer is remembered
+ * and checked first, which skips hashing the arguments.
+ */
+enum class translationKind_t
+{
+	GETTEXT,
+	PGETTEXT,
+	PLURAL,
+};
+
+struct cachedTranslation_t
+{
+	translationKind_t kind;
+	std::string       msgid;
+	std::string       other; // context or plural msgid
+	int               number;
+	const char        *translation;
+};
+
+// the arguments of a recent call and the entry it found
+struct translationCaller_t
+{
+	const char          *msgid;
+	const char          *other;
+	cachedTranslation_t *cached;
+};
+
+static std::unordered_map<size_t, std::vector<std::unique_ptr<cachedTranslation_t>>> translationCalls;
+static std::unordered_set<std::string> translatedStrings;
+
+// the last call with a msgid pointer, indexed by Trans_CallerSlot
+static const int TRANSLATION_CALLERS = 256;
+static translationCaller_t translationCallers[ TRANSLATION_CALLERS ];
 
 // Should be ROM but that doesn't work in gamelogic
 static Cvar::Cvar<std::string> trans_encodings("trans_encodings", "Supported values for 'language' cvar", Cvar::NONE, "");
@@ -179,6 +221,268 @@ public:
 
 static tinygettext::DictionaryManager trans_manager{ "UTF-8", Util::make_unique<DaemonFileSystem>() };
 
+/*
+====================
+TranslationCatalog
+
+Binary catalog compiled from a .po file by tools/compile-translations, see
+there for the format. Only the catalog of the active language is loaded, and
+it is searched in place instead of being parsed into a dictionary.
+====================
+*/
+
+class TranslationCatalog
+{
+public:
+	bool Load( const std::string& filename )
+	{
+		std::error_code err;
+
+		Clear();
+		data = FS::PakPath::ReadFile( filename, err );
+
+		if ( err )
+		{
+			data.clear();
+			return false;
+		}
+
+		if ( !Validate() )
+		{
+			LOG.Warn( "Ignoring invalid translation catalog %s", filename );
+			Clear();
+			return false;
+		}
+
+		return true;
+	}
+
+	void Clear()
+	{
+		data.clear();
+		numEntries = 0;
+		pluralForms = PluralForms();
+	}
+
+	bool IsLoaded() const
+	{
+		return !data.empty();
+	}
+
+	std::string Translate( const char *msgid ) const
+	{
+		return Singular( msgid, msgid );
+	}
+
+	std::string TranslateCtxt( const char *ctxt, const char *msgid ) const
+	{
+		return Singular( Context( ctxt, msgid ), msgid );
+	}
+
+	std::string TranslatePlural( const char *msgid, const char *msgid_plural, int number ) const
+	{
+		return Plural( msgid, msgid, msgid_plural, number );
+	}
+
+	std::string TranslateCtxtPlural( const char *ctxt, const char *msgid, const char *msgid_plural, int number ) const
+	{
+		return Plural( Context( ctxt, msgid ), msgid, msgid_plural, number );
+	}
+
+	// Calls func( key, forms ) for every entry
+	template<typename Func>
+	void ForEach( Func func ) const
+	{
+		for ( size_t i = 0; i < numEntries; i++ )
+		{
+			entry_t entry = Entry( i );
+			func( std::string( blob() + entry.keyOffset, entry.keyLength ),
+			      Forms( blob() + entry.valueOffset, entry.valueLength ) );
+		}
+	}
+
+private:
+	struct entry_t
+	{
+		uint32_t keyOffset;
+		uint32_t keyLength;
+		uint32_t valueOffset;
+		uint32_t valueLength;
+	};
+
+	static const uint32_t CATALOG_VERSION = 1;
+
+	static std::string Context( const char *ctxt, const char *msgid )
+	{
+		return std::string( ctxt ) + '\x04' + msgid;
+	}
+
+	// Splits a value into its plural forms
+	static std::vector<std::string> Forms( const char *value, size_t length )
+	{
+		std::vector<std::string> forms;
+		const char *start = value, *end = value + length;
+
+		while ( true )
+		{
+			const char *form = std::find( start, end, '\0' );
+			forms.emplace_back( start, form );
+
+			if ( form == end )
+			{
+				return forms;
+			}
+
+			start = form + 1;
+		}
+	}
+
+	uint32_t ReadU32( size_t offset ) const
+	{
+		uint32_t value;
+		memcpy( &value, data.data() + offset, sizeof( value ) );
+		return value;
+	}
+
+	entry_t Entry( size_t i ) const
+	{
+		entry_t entry;
+		memcpy( &entry, data.data() + tableOffset + i * sizeof( entry_t ), sizeof( entry ) );
+		return entry;
+	}
+
+	const char *blob() const
+	{
+		return data.data() + blobOffset;
+	}
+
+	bool Validate()
+	{
+		// magic, version, number of entries, plural forms length
+		if ( data.size() < 16 || memcmp( data.data(), "UTRC", 4 ) || ReadU32( 4 ) != CATALOG_VERSION )
+		{
+			return false;
+		}
+
+		size_t pluralLength = ReadU32( 12 );
+
+		if ( pluralLength > data.size() - 16 )
+		{
+			return false;
+		}
+
+		numEntries = ReadU32( 8 );
+		tableOffset = 16 + pluralLength;
+
+		if ( numEntries > ( data.size() - tableOffset ) / sizeof( entry_t ) )
+		{
+			return false;
+		}
+
+		blobOffset = tableOffset + numEntries * sizeof( entry_t );
+		size_t blobSize = data.size() - blobOffset;
+
+		for ( size_t i = 0; i < numEntries; i++ )
+		{
+			entry_t entry = Entry( i );
+
+			if ( entry.keyOffset > blobSize || entry.keyLength > blobSize - entry.keyOffset
+			     || entry.valueOffset > blobSize || entry.valueLength > blobSize - entry.valueOffset )
+			{
+				return false;
+			}
+		}
+
+		pluralForms = PluralForms::from_string( data.substr( 16, pluralLength ) );
+
+		return true;
+	}
+
+	// Binary search for the entry of key
+	bool Find( const std::string& key, const char *&value, size_t &length ) const
+	{
+		size_t low = 0, high = numEntries;
+
+		while ( low < high )
+		{
+			size_t middle = low + ( high - low ) / 2;
+			entry_t entry = Entry( middle );
+
+			int order = memcmp( blob() + entry.keyOffset, key.data(), std::min<size_t>( entry.keyLength, key.size() ) );
+
+			if ( order == 0 )
+			{
+				order = entry.keyLength < key.size() ? -1 : entry.keyLength > key.size();
+			}
+
+			if ( order < 0 )
+			{
+				low = middle + 1;
+			}
+			else if ( order > 0 )
+			{
+				high = middle;
+			}
+			else
+			{
+				value = blob() + entry.valueOffset;
+				length = entry.valueLength;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	// Like tinygettext, the first form of plural entries
+	std::string Singular( const std::string& key, const char *msgid ) const
+	{
+		const char *value;
+		size_t     length;
+
+		if ( Find( key, value, length ) )
+		{
+			return std::string( value, std::find( value, value + length, '\0' ) );
+		}
+
+		return msgid;
+	}
+
+	// Picks the plural form the way tinygettext does
+	std::string Plural( const std::string& key, const char *msgid, const char *msgid_plural, int number ) const
+	{
+		const char *value;
+		size_t     length;
+
+		if ( Find( key, value, length ) )
+		{
+			std::vector<std::string> forms = Forms( value, length );
+
+			if ( forms.size() == 1 )
+			{
+				return forms[ 0 ];
+			}
+
+			unsigned int form = pluralForms.get_nplural() ? pluralForms.get_plural( number ) : 0;
+
+			if ( form < forms.size() && !forms[ form ].empty() )
+			{
+				return forms[ form ];
+			}
+		}
+
+		return number == 1 ? msgid : msgid_plural;
+	}
+
+	std::string data;
+	size_t      numEntries = 0;
+	size_t      tableOffset = 0;
+	size_t      blobOffset = 0;
+	PluralForms pluralForms;
+};
+
+static TranslationCatalog trans_catalog;
+
 /*
 ====================
 Logging functions used by tinygettext
@@ -250,6 +554,17 @@ static void Trans_SetLanguage( const char* lang )
 
 	trans_manager.set_language( bestLang );
 
+	// prefer the compiled catalog, the .po file is only parsed without one
+	if ( trans_catalog.Load( "translation/game/" + bestLang.str() + ".trc" ) )
+	{
+		LOG.Verbose( "Using the translation catalog for %s", bestLang.str() );
+	}
+
+	// the old translations are no longer wanted
+	translationCalls.clear();
+	translatedStrings.clear();
+	memset( translationCallers, 0, sizeof( translationCallers ) );
+
 	LOG.Notice( "Set language to %s" , bestLang.get_name().c_str() );
 }
 
@@ -297,6 +612,96 @@ void Trans_Init()
 	Trans_SetLanguage( Cvar::GetValue( "language" ).c_str() );
 }
 
+/*
+============
+Trans_CallHash
+
+FNV-1a over the arguments of a translation call
+============
+*/
+static size_t Trans_CallHash( translationKind_t kind, const char *msgid, const char *other )
+{
+	size_t hash = 2166136261u;
+
+	auto mix = [ &hash ]( const void *data, size_t size ) {
+		const unsigned char *bytes = static_cast<const unsigned char *>( data );
+
+		for ( size_t i = 0; i < size; i++ )
+		{
+			hash = ( hash ^ bytes[ i ] ) * 16777619u;
+		}
+	};
+
+	// the terminators keep the strings from running into each other
+	mix( msgid, strlen( msgid ) + 1 );
+	mix( other, strlen( other ) + 1 );
+	mix( &kind, sizeof( kind ) );
+
+	return hash;
+}
+
+/*
+============
+Trans_CallerSlot
+============
+*/
+static int Trans_CallerSlot( const char *msgid )
+{
+	// the low bits are mostly alignment
+	return ( reinterpret_cast<uintptr_t>( msgid ) >> 3 ) % TRANSLATION_CALLERS;
+}
+
+/*
+============
+Trans_Cached
+
+Returns the translation of a call with these arguments, translating if it
+isn't cached yet. Every message keeps a single entry, whose plural number
+is updated, so that the cache only grows with the number of messages.
+============
+*/
+template<typename Translate>
+static const char *Trans_Cached( translationKind_t kind, const char *msgid, const char *other, int number, Translate translate )
+{
+	translationCaller_t &recent = translationCallers[ Trans_CallerSlot( msgid ) ];
+
+	// the same buffers may hold other text by now, so the contents are checked too
+	if ( recent.msgid == msgid && recent.other == other && recent.cached->kind == kind
+	     && recent.cached->number == number && !strcmp( recent.cached->msgid.c_str(), msgid )
+	     && !strcmp( recent.cached->other.c_str(), other ) )
+	{
+		return recent.cached->translation;
+	}
+
+	std::vector<std::unique_ptr<cachedTranslation_t>> &entries = translationCalls[ Trans_CallHash( kind, msgid, other ) ];
+	cachedTranslation_t *cached = nullptr;
+
+	for ( const std::unique_ptr<cachedTranslation_t> &entry : entries )
+	{
+		if ( entry->kind == kind && entry->msgid == msgid && entry->other == other )
+		{
+			cached = entry.get();
+			break;
+		}
+	}
+
+	if ( !cached )
+	{
+		const char *translation = translatedStrings.insert( translate() ).first->c_str();
+		entries.emplace_back( new cachedTranslation_t{ kind, msgid, other, number, translation } );
+		cached = entries.back().get();
+	}
+	else if ( cached->number != number )
+	{
+		cached->number = number;
+		cached->translation = translatedStrings.insert( translate() ).first->c_str();
+	}
+
+	recent = { msgid, other, cached };
+
+	return cached->translation;
+}
+
 const char* Trans_Gettext( const char *msgid )
 {
 	LOG.Debug( "translate[_]: %s", msgid );
@@ -305,9 +710,14 @@ const char* Trans_Gettext( const char *msgid )
 		return msgid;
 	}
 
-	num = ( num + 1 ) & 3;
-	gettextbuffer[ num ] = trans_manager.get_dictionary().translate( msgid );
-	return gettextbuffer[ num ].c_str();
+	return Trans_Cached( translationKind_t::GETTEXT, msgid, "", 0, [ & ] {
+		if ( trans_catalog.IsLoaded() )
+		{
+			return trans_catalog.Translate( msgid );
+		}
+
+		return std::string( trans_manager.get_dictionary().translate( msgid ) );
+	} );
 }
 
 const char* Trans_Pgettext( const char *ctxt, const char *msgid )
@@ -318,9 +728,14 @@ const char* Trans_Pgettext( const char *ctxt, const char *msgid )
 		return msgid;
 	}
 
-	num = ( num + 1 ) & 3;
-	gettextbuffer[ num ] = trans_manager.get_dictionary().translate_ctxt( ctxt, msgid );
-	return gettextbuffer[ num ].c_str();
+	return Trans_Cached( translationKind_t::PGETTEXT, msgid, ctxt, 0, [ & ] {
+		if ( trans_catalog.IsLoaded() )
+		{
+			return trans_catalog.TranslateCtxt( ctxt, msgid );
+		}
+
+		return std::string( trans_manager.get_dictionary().translate_ctxt( ctxt, msgid ) );
+	} );
 }
 
 const char* Trans_GettextPlural( const char *msgid, const char *msgid_plural, int number )
@@ -341,7 +756,68 @@ const char* Trans_GettextPlural( const char *msgid, const char *msgid_plural, in
 		return nullptr;
 	}
 
-	num = ( num + 1 ) & 3;
-	gettextbuffer[ num ] = trans_manager.get_dictionary().translate_plural( msgid, msgid_plural, number );
-	return gettextbuffer[ num ].c_str();
+	return Trans_Cached( translationKind_t::PLURAL, msgid, msgid_plural, number, [ & ] {
+		if ( trans_catalog.IsLoaded() )
+		{
+			return trans_catalog.TranslatePlural( msgid, msgid_plural, number );
+		}
+
+		return std::string( trans_manager.get_dictionary().translate_plural( msgid, msgid_plural, number ) );
+	} );
+}
+
+/*
+============
+Trans_CheckCatalog_f
+
+Compares every entry of the loaded catalog with the .po file of the language
+============
+*/
+void Trans_CheckCatalog_f()
+{
+	if ( !trans_catalog.IsLoaded() )
+	{
+		Log::Notice( "No translation catalog loaded" );
+		return;
+	}
+
+	static const int numbers[] = { 0, 1, 2, 3, 4, 5, 11, 21, 22, 25, 101, 111 };
+	Dictionary &dictionary = trans_manager.get_dictionary();
+	int numEntries = 0, numMismatches = 0;
+
+	trans_catalog.ForEach( [ & ]( const std::string &key, const std::vector<std::string> &forms ) {
+		size_t separator = key.find( '\x04' );
+		std::string ctxt = separator == std::string::npos ? "" : key.substr( 0, separator );
+		std::string msgid = separator == std::string::npos ? key : key.substr( separator + 1 );
+		bool mismatch = false;
+
+		numEntries++;
+
+		if ( forms.size() == 1 )
+		{
+			std::string expected = ctxt.empty() ? dictionary.translate( msgid ) : dictionary.translate_ctxt( ctxt, msgid );
+			std::string actual = ctxt.empty() ? trans_catalog.Translate( msgid.c_str() )
+			                                  : trans_catalog.TranslateCtxt( ctxt.c_str(), msgid.c_str() );
+			mismatch = expected != actual;
+		}
+		else
+		{
+			for ( int number : numbers )
+			{
+				std::string expected = ctxt.empty() ? dictionary.translate_plural( msgid, msgid, number )
+				                                    : dictionary.translate_ctxt_plural( ctxt, msgid, msgid, number );
+				std::string actual = ctxt.empty() ? trans_catalog.TranslatePlural( msgid.c_str(), msgid.c_str(), number )
+				                                  : trans_catalog.TranslateCtxtPlural( ctxt.c_str(), msgid.c_str(), msgid.c_str(), number );
+				mismatch |= expected != actual;
+			}
+		}
+
+		if ( mismatch )
+		{
+			LOG.Warn( "Translation catalog differs for \"%s\"", msgid );
+			numMismatches++;
+		}
+	} );
+
+	Log::Notice( "%d of %d catalog entries differ from the .po file", numMismatches, numEntries );
 }
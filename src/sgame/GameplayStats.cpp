@@ -0,0 +1,337 @@
+/*
+===========================================================================
+
+Unvanquished GPL Source Code
+Copyright (C) 2022 Unvanquished Developers
+
+This file is part of the Unvanquished GPL Source Code (Unvanquished Source Code).
+
+Unvanquished is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Unvanquished is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Unvanquished.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+
+#include "sg_local.h"
+#include "Entities.h"
+
+/*
+ * Binary gameplay statistics stream, see tools/convert-gameplay-stats.
+ *
+ * All values are little endian.
+ *
+ * file    := "UGST" version:u32 numTables:u8 table[numTables] record*
+ * table   := id:u8 name:str numColumns:u8 { name:str type:u8 }[numColumns]
+ * record  := tableId:u8 size:u32 value[numColumns]   (size in bytes of the values)
+ * value   := i32 | f32 | str
+ * str     := length:u16 bytes
+ *
+ * Readers must skip records of unknown tables using their size and ignore
+ * trailing columns they don't know about, so columns may only be appended.
+ */
+namespace GameplayStats {
+	static const char     STATS_MAGIC[ 4 ] = { 'U', 'G', 'S', 'T' };
+	// Increment this if you change the meaning of existing columns
+	static const uint32_t STATS_VERSION = 1;
+
+	// write the buffer to disk once it grows larger than this
+	static const size_t   FLUSH_SIZE = 16 * 1024;
+
+	enum columnType_t : uint8_t {
+		COL_INT,
+		COL_FLOAT,
+		COL_STRING,
+	};
+
+	enum statsTable_t : uint8_t {
+		TABLE_MATCH,
+		TABLE_TEAM,
+		TABLE_CLIENT,
+		TABLE_RESULT,
+
+		NUM_TABLES
+	};
+
+	struct column_t {
+		const char   *name;
+		columnType_t type;
+	};
+
+	struct table_t {
+		const char             *name;
+		std::vector<column_t> columns;
+	};
+
+	static const table_t tables[ NUM_TABLES ] = {
+		{ "match", {
+			{ "version",            COL_STRING },
+			{ "map",                COL_STRING },
+			{ "date",               COL_STRING },
+			{ "momentumHalfLife",   COL_FLOAT  },
+			{ "initialBuildPoints", COL_INT    },
+			{ "budgetPerMiner",     COL_INT    },
+		} },
+		{ "team", {
+			{ "time",               COL_INT    }, // match time in ms
+			{ "team",               COL_INT    },
+			{ "clients",            COL_INT    },
+			{ "bots",               COL_INT    },
+			{ "momentum",           COL_FLOAT  },
+			{ "totalBudget",        COL_FLOAT  },
+			{ "freeBudget",         COL_INT    },
+			{ "buildableValue",     COL_INT    },
+			{ "kills",              COL_INT    },
+			{ "averageCredits",     COL_INT    },
+			{ "averageValue",       COL_INT    },
+		} },
+		{ "client", {
+			{ "time",               COL_INT    },
+			{ "client",             COL_INT    },
+			{ "team",               COL_INT    },
+			{ "bot",                COL_INT    },
+			{ "class",              COL_INT    },
+			{ "weapon",             COL_INT    },
+			{ "alive",              COL_INT    },
+			{ "credits",            COL_INT    },
+			{ "value",              COL_INT    },
+			{ "score",              COL_INT    },
+		} },
+		{ "result", {
+			{ "time",               COL_INT    },
+			{ "winner",             COL_INT    },
+			{ "averageAlienPlayers", COL_FLOAT },
+			{ "averageAlienBots",   COL_FLOAT  },
+			{ "averageHumanPlayers", COL_FLOAT },
+			{ "averageHumanBots",   COL_FLOAT  },
+		} },
+	};
+
+	static fileHandle_t file = 0;
+	static std::string  buffer;
+
+	static void Flush() {
+		if ( file && !buffer.empty() ) {
+			trap_FS_Write( buffer.data(), static_cast<int>( buffer.size() ), file );
+			buffer.clear();
+		}
+	}
+
+	static void WriteBytes( const void *data, size_t size ) {
+		buffer.append( reinterpret_cast<const char*>( data ), size );
+	}
+
+	static void WriteU8( uint8_t value ) {
+		WriteBytes( &value, sizeof( value ) );
+	}
+
+	/**
+	 * @brief Stores an unsigned value of the given size in little endian order.
+	 */
+	static void StoreLittleEndian( char *out, uint32_t value, size_t size ) {
+		for ( size_t i = 0; i < size; i++ ) {
+			out[ i ] = static_cast<char>( ( value >> ( 8 * i ) ) & 0xff );
+		}
+	}
+
+	static void WriteU16( uint16_t value ) {
+		char bytes[ sizeof( value ) ];
+		StoreLittleEndian( bytes, value, sizeof( value ) );
+		WriteBytes( bytes, sizeof( bytes ) );
+	}
+
+	static void WriteU32( uint32_t value ) {
+		char bytes[ sizeof( value ) ];
+		StoreLittleEndian( bytes, value, sizeof( value ) );
+		WriteBytes( bytes, sizeof( bytes ) );
+	}
+
+	static void WriteString( Str::StringRef value ) {
+		uint16_t length = static_cast<uint16_t>( std::min<size_t>( value.size(), UINT16_MAX ) );
+		WriteU16( length );
+		WriteBytes( value.data(), length );
+	}
+
+	/**
+	 * @brief Appends one length-prefixed row to the buffer.
+	 */
+	class Record {
+		public:
+			explicit Record( statsTable_t table ) {
+				WriteU8( table );
+				sizeOffset = buffer.size();
+				WriteU32( 0 );
+			}
+
+			~Record() {
+				uint32_t size = static_cast<uint32_t>( buffer.size() - sizeOffset - sizeof( uint32_t ) );
+				StoreLittleEndian( &buffer[ sizeOffset ], size, sizeof( size ) );
+			}
+
+			Record &Int( int32_t value ) {
+				WriteU32( static_cast<uint32_t>( value ) );
+				return *this;
+			}
+
+			Record &Float( float value ) {
+				uint32_t bits;
+				memcpy( &bits, &value, sizeof( bits ) );
+				WriteU32( bits );
+				return *this;
+			}
+
+			Record &String( Str::StringRef value ) {
+				WriteString( value );
+				return *this;
+			}
+
+		private:
+			size_t sizeOffset;
+	};
+
+	bool Open( const char *fileName ) {
+		if ( trap_FS_FOpenFile( fileName, &file, fsMode_t::FS_WRITE ) < 0 ) {
+			file = 0;
+		}
+
+		if ( !file ) {
+			return false;
+		}
+
+		buffer.clear();
+		WriteBytes( STATS_MAGIC, sizeof( STATS_MAGIC ) );
+		WriteU32( STATS_VERSION );
+
+		WriteU8( NUM_TABLES );
+		for ( int i = 0; i < NUM_TABLES; i++ ) {
+			WriteU8( i );
+			WriteString( tables[ i ].name );
+			WriteU8( tables[ i ].columns.size() );
+
+			for ( const column_t &column : tables[ i ].columns ) {
+				WriteString( column.name );
+				WriteU8( column.type );
+			}
+		}
+
+		return true;
+	}
+
+	bool IsOpen() {
+		return file != 0;
+	}
+
+	void Close() {
+		if ( !file ) {
+			return;
+		}
+
+		Flush();
+		trap_FS_FCloseFile( file );
+		file = 0;
+	}
+
+	void WriteHeader() {
+		if ( !file ) {
+			return;
+		}
+
+		qtime_t t;
+		Com_GMTime( &t );
+
+		Record( TABLE_MATCH )
+			.String( Q3_VERSION )
+			.String( Cvar::GetValue( "mapname" ) )
+			.String( va( "%04i-%02i-%02i %02i:%02i:%02i",
+			             t.tm_year + 1900, t.tm_mon + 1, t.tm_mday,
+			             t.tm_hour, t.tm_min, t.tm_sec ) )
+			.Float( g_momentumHalfLife.Get() )
+			.Int( g_buildPointInitialBudget.Get() )
+			.Int( g_buildPointBudgetPerMiner.Get() );
+
+		Flush();
+	}
+
+	void WriteSample() {
+		if ( !file ) {
+			return;
+		}
+
+		int credits[ NUM_TEAMS ] = {};
+		int value[ NUM_TEAMS ] = {};
+		int count[ NUM_TEAMS ] = {};
+		int buildableValue[ NUM_TEAMS ] = {};
+
+		// one pass over the clients for both the client rows and the team averages
+		for ( int i = 0; i < level.maxclients; i++ ) {
+			gclient_t *client = &g_clients[ i ];
+
+			if ( !client->ent()->inuse ) continue;
+
+			team_t team = client->pers.team;
+			int playerValue = BG_GetPlayerValue( client->ps );
+
+			credits[ team ] += client->pers.credit;
+			value[ team ] += playerValue;
+			count[ team ]++;
+
+			Record( TABLE_CLIENT )
+				.Int( level.matchTime )
+				.Int( i )
+				.Int( team )
+				.Int( ( client->ent()->r.svFlags & SVF_BOT ) != 0 )
+				.Int( client->ps.stats[ STAT_CLASS ] )
+				.Int( client->ps.stats[ STAT_WEAPON ] )
+				.Int( Entities::IsAlive( client->ent() ) )
+				.Int( client->pers.credit )
+				.Int( playerValue )
+				.Int( client->ps.persistant[ PERS_SCORE ] );
+		}
+
+		G_GetTotalBuildableValues( buildableValue );
+
+		for ( team_t team = TEAM_NONE; ( team = G_IterateTeams( team ) ); ) {
+			Record( TABLE_TEAM )
+				.Int( level.matchTime )
+				.Int( team )
+				.Int( level.team[ team ].numClients )
+				.Int( level.team[ team ].numBots )
+				.Float( level.team[ team ].momentum )
+				.Float( level.team[ team ].totalBudget )
+				.Int( G_GetFreeBudget( team ) )
+				.Int( buildableValue[ team ] )
+				.Int( level.team[ team ].kills )
+				.Int( count[ team ] ? credits[ team ] / count[ team ] : 0 )
+				.Int( count[ team ] ? value[ team ] / count[ team ] : 0 );
+		}
+
+		if ( buffer.size() > FLUSH_SIZE ) {
+			Flush();
+		}
+	}
+
+	void WriteFooter() {
+		if ( !file ) {
+			return;
+		}
+
+		Record( TABLE_RESULT )
+			.Int( level.matchTime )
+			.Int( level.lastWin )
+			.Float( level.team[ TEAM_ALIENS ].averageNumPlayers )
+			.Float( level.team[ TEAM_ALIENS ].averageNumBots )
+			.Float( level.team[ TEAM_HUMANS ].averageNumPlayers )
+			.Float( level.team[ TEAM_HUMANS ].averageNumBots );
+
+		Flush();
+	}
+}
@@ -0,0 +1,250 @@
+/*
+===========================================================================
+
+Unvanquished GPL Source Code
+Copyright (C) 2022 Unvanquished Developers
+
+This file is part of the Unvanquished GPL Source Code (Unvanquished Source Code).
+
+Unvanquished is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Unvanquished is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Unvanquished.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+
+#include "sg_local.h"
+#include "Profiler.h"
+
+#include <algorithm>
+
+static Cvar::Cvar<bool> g_profile("g_profile", "record per-frame timing zones for profileDump", Cvar::NONE, false);
+
+namespace Profiler {
+	// Number of frames kept in the ring buffer, about two minutes at sv_fps 40.
+	static const int MAX_PROFILE_FRAMES = 4096;
+
+	static const char *const zoneNames[ NUM_ZONES ] = {
+		"G_RunFrame",
+		"entities",
+		"ClientEndFrame",
+		"G_UnlaggedStore",
+		"G_RecoverBuildPoints",
+		"G_UpdateBuildablePowerStates",
+		"G_DecreaseMomentum",
+		"momentum and budget journal",
+		"G_SpawnClients",
+		"G_UpdateZaps",
+		"Beacon::Frame",
+		"G_PrepareEntityNetCode",
+		"G_LogGameplayStats",
+		"G_BotBackgroundNavgen",
+		"G_BotFill",
+		"CheckTeamStatus",
+		"G_BotUpdateObstacles",
+		"G_RunMissile",
+		"G_Physics (buildable)",
+		"G_Physics (corpse)",
+		"G_RunMover",
+		"G_Physics",
+		"G_RunClient",
+		"G_RunThink",
+	};
+
+	struct zoneSample_t {
+		int firstStart; // usec since frame start, -1 if the zone did not run
+		int total;      // usec
+		int calls;
+	};
+
+	struct frameSample_t {
+		int          levelTime;
+		int64_t      start; // usec since the first recorded frame
+		zoneSample_t zones[ NUM_ZONES ];
+	};
+
+	bool enabled = false;
+
+	static frameSample_t     frames[ MAX_PROFILE_FRAMES ];
+	static int               nextFrame = 0;
+	static int               numFrames = 0;
+
+	static frameSample_t     current;
+	static bool              inFrame = false;
+	static clock::time_point frameStart;
+	static clock::time_point epoch;
+	static bool              epochSet = false;
+
+	static int Microseconds( clock::duration d ) {
+		return static_cast<int>( std::chrono::duration_cast<std::chrono::microseconds>( d ).count() );
+	}
+
+	void BeginFrame( int levelTime ) {
+		enabled = g_profile.Get();
+
+		if ( !enabled ) {
+			inFrame = false;
+			return;
+		}
+
+		frameStart = clock::now();
+
+		if ( !epochSet ) {
+			epoch = frameStart;
+			epochSet = true;
+		}
+
+		current.levelTime = levelTime;
+		current.start = std::chrono::duration_cast<std::chrono::microseconds>( frameStart - epoch ).count();
+
+		for ( zoneSample_t &zone : current.zones ) {
+			zone.firstStart = -1;
+			zone.total = 0;
+			zone.calls = 0;
+		}
+
+		inFrame = true;
+	}
+
+	void Record( zone_t zone, clock::time_point start, clock::time_point end ) {
+		if ( !inFrame ) {
+			return;
+		}
+
+		zoneSample_t &sample = current.zones[ zone ];
+
+		if ( sample.firstStart < 0 ) {
+			sample.firstStart = Microseconds( start - frameStart );
+		}
+
+		sample.total += Microseconds( end - start );
+		sample.calls++;
+	}
+
+	void EndFrame() {
+		if ( !inFrame ) {
+			return;
+		}
+
+		Record( ZONE_FRAME, frameStart, clock::now() );
+		inFrame = false;
+
+		frames[ nextFrame ] = current;
+		nextFrame = ( nextFrame + 1 ) % MAX_PROFILE_FRAMES;
+		numFrames = std::min( numFrames + 1, MAX_PROFILE_FRAMES );
+	}
+
+	/**
+	 * @return The i-th of the last count recorded frames, oldest first.
+	 */
+	static const frameSample_t &RecentFrame( int count, int i ) {
+		int index = ( nextFrame - count + i + MAX_PROFILE_FRAMES ) % MAX_PROFILE_FRAMES;
+		return frames[ index ];
+	}
+
+	static int ClampFrameCount( int count ) {
+		if ( count <= 0 || count > numFrames ) {
+			return numFrames;
+		}
+
+		return count;
+	}
+
+	int WriteTrace( const char *fileName, int count ) {
+		fileHandle_t f;
+
+		count = ClampFrameCount( count );
+
+		if ( !count ) {
+			return 0;
+		}
+
+		if ( trap_FS_FOpenFile( fileName, &f, fsMode_t::FS_WRITE ) < 0 || !f ) {
+			Log::Warn( "profileDump: couldn't open %s for writing", fileName );
+			return 0;
+		}
+
+		std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+		bool first = true;
+
+		// Give every zone its own track, since accumulated zones of one frame may overlap.
+		for ( int zone = 0; zone < NUM_ZONES; zone++ ) {
+			json += Str::Format( "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,"
+			                     "\"args\":{\"name\":\"%s\"}}",
+			                     first ? "" : ",\n", zone, zoneNames[ zone ] );
+			first = false;
+		}
+
+		int64_t base = RecentFrame( count, 0 ).start;
+
+		for ( int i = 0; i < count; i++ ) {
+			const frameSample_t &frame = RecentFrame( count, i );
+
+			for ( int zone = 0; zone < NUM_ZONES; zone++ ) {
+				const zoneSample_t &sample = frame.zones[ zone ];
+
+				if ( !sample.calls ) {
+					continue;
+				}
+
+				json += Str::Format( ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,"
+				                     "\"ts\":%d,\"dur\":%d,\"args\":{\"calls\":%d,\"levelTime\":%d}}",
+				                     zoneNames[ zone ], zone,
+				                     static_cast<int>( frame.start - base ) + sample.firstStart,
+				                     sample.total, sample.calls, frame.levelTime );
+			}
+		}
+
+		json += "\n]}\n";
+
+		trap_FS_Write( json.data(), static_cast<int>( json.size() ), f );
+		trap_FS_FCloseFile( f );
+
+		return count;
+	}
+
+	void PrintSummary( int count ) {
+		count = ClampFrameCount( count );
+
+		if ( !count ) {
+			Log::Notice( "profileDump: no frames recorded, set g_profile 1 first" );
+			return;
+		}
+
+		std::vector<int> times;
+		times.reserve( count );
+
+		Log::Notice( "^3%-30s %8s %8s %8s %8s (usec over %d frames)", "zone", "p50", "p99", "max", "calls", count );
+
+		for ( int zone = 0; zone < NUM_ZONES; zone++ ) {
+			int calls = 0;
+			times.clear();
+
+			for ( int i = 0; i < count; i++ ) {
+				const zoneSample_t &sample = RecentFrame( count, i ).zones[ zone ];
+				times.push_back( sample.total );
+				calls += sample.calls;
+			}
+
+			if ( !calls ) {
+				continue;
+			}
+
+			std::sort( times.begin(), times.end() );
+
+			int p50 = times[ ( times.size() - 1 ) * 50 / 100 ];
+			int p99 = times[ ( times.size() - 1 ) * 99 / 100 ];
+
+			Log::Notice( "%-30s %8d %8d %8d %8d", zoneNames[ zone ], p50, p99, times.back(), calls );
+		}
+	}
+}
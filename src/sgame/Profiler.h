@@ -0,0 +1,123 @@
+/*
+===========================================================================
+
+Unvanquished GPL Source Code
+Copyright (C) 2022 Unvanquished Developers
+
+This file is part of the Unvanquished GPL Source Code (Unvanquished Source Code).
+
+Unvanquished is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Unvanquished is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Unvanquished.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+
+#ifndef SGAME_PROFILER_H_
+#define SGAME_PROFILER_H_
+
+#include <chrono>
+
+/*
+ * Lightweight per-frame timing zones for G_RunFrame.
+ *
+ * Every zone accumulates its total time and call count for the current frame.
+ * Finished frames are pushed into a fixed-size ring buffer which can be dumped
+ * with the "profileDump" server command, either as a p50/p99 summary or as a
+ * Chrome trace (chrome://tracing, Perfetto).
+ *
+ * Profiling is toggled with g_profile. When it is off, a zone costs a branch
+ * on Profiler::enabled when it starts and one on its own flag when it ends.
+ */
+namespace Profiler {
+	enum zone_t {
+		ZONE_FRAME,
+		ZONE_ENTITIES,
+		ZONE_CLIENT_END_FRAME,
+		ZONE_UNLAGGED_STORE,
+		ZONE_RECOVER_BUILD_POINTS,
+		ZONE_BUILDABLE_POWER_STATES,
+		ZONE_DECREASE_MOMENTUM,
+		ZONE_TEAM_JOURNAL,
+		ZONE_SPAWN_CLIENTS,
+		ZONE_UPDATE_ZAPS,
+		ZONE_BEACONS,
+		ZONE_ENTITY_NETCODE,
+		ZONE_GAMEPLAY_STATS,
+		ZONE_BOT_NAVGEN,
+		ZONE_BOT_FILL,
+		ZONE_TEAM_STATUS,
+		ZONE_BOT_OBSTACLES,
+
+		// per-entity dispatch in the entity loop, accumulated over the frame
+		ZONE_RUN_MISSILE,
+		ZONE_RUN_BUILDABLE,
+		ZONE_RUN_CORPSE,
+		ZONE_RUN_MOVER,
+		ZONE_RUN_PHYSICS,
+		ZONE_RUN_CLIENT,
+		ZONE_RUN_THINK,
+
+		NUM_ZONES
+	};
+
+	using clock = std::chrono::steady_clock;
+
+	// Mirrors g_profile, latched at the start of every frame.
+	extern bool enabled;
+
+	void BeginFrame( int levelTime );
+	void EndFrame();
+	void Record( zone_t zone, clock::time_point start, clock::time_point end );
+
+	// Writes the last numFrames frames as Chrome trace JSON to fileName.
+	// Returns the number of frames written.
+	int  WriteTrace( const char *fileName, int numFrames );
+
+	// Prints p50/p99/max per zone over the last numFrames frames.
+	void PrintSummary( int numFrames );
+
+	/**
+	 * @brief Times the enclosing scope and records it into the given zone.
+	 *
+	 * Only the constructor tests enabled, so a zone started before g_profile
+	 * changes still ends the way it started.
+	 */
+	class Zone {
+		public:
+			explicit Zone( zone_t zone ) : zone( zone ), active( enabled ) {
+				if ( active ) {
+					start = clock::now();
+				}
+			}
+
+			~Zone() {
+				if ( active ) {
+					Stop();
+				}
+			}
+
+			Zone( const Zone& ) = delete;
+			Zone& operator=( const Zone& ) = delete;
+
+		private:
+			void Stop() { Record( zone, start, clock::now() ); }
+
+			zone_t            zone;
+			bool              active;
+			clock::time_point start;
+	};
+}
+
+#define G_PROFILE_ZONE( zone ) Profiler::Zone profileZone_##zone( Profiler::zone )
+
+#endif // SGAME_PROFILER_H_
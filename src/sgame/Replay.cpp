@@ -0,0 +1,553 @@
+/*
+===========================================================================
+
+Unvanquished GPL Source Code
+Copyright (C) 2022 Unvanquished Developers
+
+This file is part of the Unvanquished GPL Source Code (Unvanquished Source Code).
+
+Unvanquished is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Unvanquished is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Unvanquished.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+
+#include "sg_local.h"
+#include "Replay.h"
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+
+static Cvar::Cvar<std::string> g_replayRecord("g_replayRecord", "record the game inputs to this file", Cvar::NONE, "");
+static Cvar::Cvar<std::string> g_replayPlay("g_replayPlay", "replay the game inputs from this file as a benchmark", Cvar::NONE, "");
+
+namespace Replay {
+	static const char     REPLAY_MAGIC[ 4 ] = { 'U', 'N', 'V', 'R' };
+	static const uint32_t REPLAY_VERSION = 1;
+
+	// flush the recording buffer to disk once it grows larger than this
+	static const size_t   FLUSH_SIZE = 64 * 1024;
+
+	enum replayEvent_t : uint8_t {
+		RE_FRAME,
+		RE_CONNECT,
+		RE_USERINFO,
+		RE_BEGIN,
+		RE_USERCMD,
+		RE_CLIENT_COMMAND,
+		RE_DISCONNECT,
+		RE_CONSOLE_COMMAND,
+	};
+
+	/*
+	 * Recording
+	 */
+
+	static fileHandle_t recordFile = 0;
+	static std::string  recordBuffer;
+
+	static void Flush() {
+		if ( recordFile && !recordBuffer.empty() ) {
+			trap_FS_Write( recordBuffer.data(), static_cast<int>( recordBuffer.size() ), recordFile );
+			recordBuffer.clear();
+		}
+	}
+
+	static void WriteBytes( const void *data, size_t size ) {
+		recordBuffer.append( reinterpret_cast<const char*>( data ), size );
+	}
+
+	static void WriteU8( uint8_t value ) {
+		WriteBytes( &value, sizeof( value ) );
+	}
+
+	static void WriteI32( int32_t value ) {
+		WriteBytes( &value, sizeof( value ) );
+	}
+
+	static void WriteString( Str::StringRef value ) {
+		WriteI32( static_cast<int32_t>( value.size() ) );
+		WriteBytes( value.data(), value.size() );
+	}
+
+	static void WriteUserinfo( int clientNum ) {
+		char userinfo[ MAX_INFO_STRING ];
+		trap_GetUserinfo( clientNum, userinfo, sizeof( userinfo ) );
+		WriteString( userinfo );
+	}
+
+	static bool RecordingClient( int clientNum ) {
+		return recordFile && !( g_entities[ clientNum ].r.svFlags & SVF_BOT );
+	}
+
+	bool Recording() {
+		return recordFile != 0;
+	}
+
+	void RecordConnect( int clientNum, bool firstTime ) {
+		if ( !RecordingClient( clientNum ) ) return;
+
+		WriteU8( RE_CONNECT );
+		WriteU8( clientNum );
+		WriteU8( firstTime );
+		WriteUserinfo( clientNum );
+	}
+
+	void RecordUserinfoChanged( int clientNum ) {
+		if ( !RecordingClient( clientNum ) ) return;
+
+		WriteU8( RE_USERINFO );
+		WriteU8( clientNum );
+		WriteUserinfo( clientNum );
+	}
+
+	void RecordBegin( int clientNum ) {
+		if ( !RecordingClient( clientNum ) ) return;
+
+		WriteU8( RE_BEGIN );
+		WriteU8( clientNum );
+	}
+
+	void RecordUsercmd( int clientNum, const usercmd_t &cmd ) {
+		if ( !RecordingClient( clientNum ) ) return;
+
+		WriteU8( RE_USERCMD );
+		WriteU8( clientNum );
+		WriteBytes( &cmd, sizeof( cmd ) );
+	}
+
+	void RecordClientCommand( int clientNum, Str::StringRef command ) {
+		if ( !RecordingClient( clientNum ) ) return;
+
+		WriteU8( RE_CLIENT_COMMAND );
+		WriteU8( clientNum );
+		WriteString( command );
+	}
+
+	void RecordDisconnect( int clientNum ) {
+		if ( !RecordingClient( clientNum ) ) return;
+
+		WriteU8( RE_DISCONNECT );
+		WriteU8( clientNum );
+	}
+
+	void RecordConsoleCommand() {
+		if ( !recordFile ) return;
+
+		std::string command;
+		char arg[ MAX_STRING_CHARS ];
+
+		for ( int i = 0; i < trap_Argc(); i++ ) {
+			trap_Argv( i, arg, sizeof( arg ) );
+
+			if ( i ) command += ' ';
+			command += Cmd::Escape( arg );
+		}
+
+		WriteU8( RE_CONSOLE_COMMAND );
+		WriteString( command );
+	}
+
+	void RecordFrame( int levelTime ) {
+		if ( !recordFile ) return;
+
+		WriteU8( RE_FRAME );
+		WriteI32( levelTime );
+
+		if ( recordBuffer.size() > FLUSH_SIZE ) {
+			Flush();
+		}
+	}
+
+	/*
+	 * Playback
+	 */
+
+	class Reader {
+		public:
+			std::vector<char> data;
+			size_t            offset = 0;
+			bool              truncated = false;
+
+			bool AtEnd() const {
+				return truncated || offset >= data.size();
+			}
+
+			bool ReadBytes( void *out, size_t size ) {
+				if ( truncated || data.size() - offset < size ) {
+					truncated = true;
+					return false;
+				}
+
+				memcpy( out, data.data() + offset, size );
+				offset += size;
+				return true;
+			}
+
+			uint8_t ReadU8() {
+				uint8_t value = 0;
+				ReadBytes( &value, sizeof( value ) );
+				return value;
+			}
+
+			int32_t ReadI32() {
+				int32_t value = 0;
+				ReadBytes( &value, sizeof( value ) );
+				return value;
+			}
+
+			std::string ReadString() {
+				int32_t size = ReadI32();
+
+				if ( size < 0 || static_cast<size_t>( size ) > data.size() - offset ) {
+					truncated = true;
+					return "";
+				}
+
+				std::string value( data.data() + offset, size );
+				offset += size;
+				return value;
+			}
+	};
+
+	static bool        playing = false;
+	static bool        finished = false;
+	static std::string replayName;
+	static Reader      reader;
+
+	// recorded client number -> client slot used during the replay
+	static int         clientSlots[ MAX_CLIENTS ];
+	static usercmd_t   usercmds[ MAX_CLIENTS ];
+	// serverTime of the last command dispatched to a slot, so none runs twice
+	static int         lastCommandTimes[ MAX_CLIENTS ];
+	static std::string userinfos[ MAX_CLIENTS ];
+
+	bool Playing() {
+		return playing;
+	}
+
+	void GetUsercmd( int clientNum, usercmd_t *cmd ) {
+		if ( playing && !( g_entities[ clientNum ].r.svFlags & SVF_BOT ) ) {
+			*cmd = usercmds[ clientNum ];
+		} else {
+			trap_GetUsercmd( clientNum, cmd );
+		}
+	}
+
+	void GetUserinfo( int clientNum, char *buffer, int bufferSize ) {
+		if ( playing && !( g_entities[ clientNum ].r.svFlags & SVF_BOT ) ) {
+			Q_strncpyz( buffer, userinfos[ clientNum ].c_str(), bufferSize );
+		} else {
+			trap_GetUserinfo( clientNum, buffer, bufferSize );
+		}
+	}
+
+	static bool Load( const char *fileName, int &levelTime, int &randomSeed ) {
+		fileHandle_t f;
+		int len = trap_FS_FOpenFile( fileName, &f, fsMode_t::FS_READ );
+
+		if ( len < 0 || !f ) {
+			Log::Warn( "replay: couldn't open %s", fileName );
+			return false;
+		}
+
+		reader = Reader();
+		reader.data.resize( len );
+		trap_FS_Read( reader.data.data(), len, f );
+		trap_FS_FCloseFile( f );
+
+		char magic[ sizeof( REPLAY_MAGIC ) ] = {};
+		reader.ReadBytes( magic, sizeof( magic ) );
+		uint32_t version = reader.ReadI32();
+
+		if ( memcmp( magic, REPLAY_MAGIC, sizeof( magic ) ) || version != REPLAY_VERSION ) {
+			Log::Warn( "replay: %s is not a version %u replay", fileName, REPLAY_VERSION );
+			return false;
+		}
+
+		if ( reader.ReadI32() != static_cast<int32_t>( sizeof( usercmd_t ) ) ) {
+			Log::Warn( "replay: %s was recorded with an incompatible usercmd_t", fileName );
+			return false;
+		}
+
+		std::string mapName = reader.ReadString();
+		levelTime = reader.ReadI32();
+		randomSeed = reader.ReadI32();
+
+		if ( reader.AtEnd() ) {
+			Log::Warn( "replay: %s is truncated", fileName );
+			return false;
+		}
+
+		if ( mapName != Cvar::GetValue( "mapname" ) ) {
+			Log::Warn( "replay: %s was recorded on %s", fileName, mapName );
+			return false;
+		}
+
+		return true;
+	}
+
+	void Init( int &levelTime, int &randomSeed ) {
+		std::string playName = g_replayPlay.Get();
+		std::string recordName = g_replayRecord.Get();
+
+		playing = false;
+		finished = false;
+
+		if ( !playName.empty() ) {
+			if ( Load( playName.c_str(), levelTime, randomSeed ) ) {
+				Log::Notice( "replay: loaded %s (%zu bytes)", playName, reader.data.size() );
+				replayName = playName;
+				playing = true;
+
+				std::fill( std::begin( clientSlots ), std::end( clientSlots ), -1 );
+				std::fill( std::begin( lastCommandTimes ), std::end( lastCommandTimes ), INT_MIN );
+			}
+
+			return;
+		}
+
+		if ( !recordName.empty() ) {
+			if ( trap_FS_FOpenFile( recordName.c_str(), &recordFile, fsMode_t::FS_WRITE ) < 0 ) {
+				recordFile = 0;
+			}
+
+			if ( !recordFile ) {
+				Log::Warn( "replay: couldn't open %s for writing", recordName );
+				return;
+			}
+
+			recordBuffer.clear();
+			WriteBytes( REPLAY_MAGIC, sizeof( REPLAY_MAGIC ) );
+			WriteI32( REPLAY_VERSION );
+			WriteI32( sizeof( usercmd_t ) );
+			WriteString( Cvar::GetValue( "mapname" ) );
+			WriteI32( levelTime );
+			WriteI32( randomSeed );
+
+			Log::Notice( "replay: recording to %s", recordName );
+		}
+	}
+
+	void Shutdown() {
+		if ( recordFile ) {
+			Flush();
+			trap_FS_FCloseFile( recordFile );
+			recordFile = 0;
+		}
+
+		playing = false;
+		reader = Reader();
+	}
+
+	/**
+	 * @brief Maps a recorded client number to a slot, reserving one from the engine on connect.
+	 */
+	static int ClientSlot( int recordedNum, bool allocate ) {
+		if ( recordedNum < 0 || recordedNum >= MAX_CLIENTS ) {
+			return -1;
+		}
+
+		if ( clientSlots[ recordedNum ] < 0 && allocate ) {
+			// the engine has no real client for this slot, so borrow a bot slot
+			clientSlots[ recordedNum ] = trap_BotAllocateClient();
+		}
+
+		return clientSlots[ recordedNum ];
+	}
+
+	/**
+	 * @brief Dispatches events up to the next frame boundary.
+	 * @return Whether a frame was reached, and its level time.
+	 */
+	static bool DispatchUntilFrame( int &levelTime ) {
+		while ( !reader.AtEnd() ) {
+			replayEvent_t event = static_cast<replayEvent_t>( reader.ReadU8() );
+
+			if ( event == RE_FRAME ) {
+				levelTime = reader.ReadI32();
+				return !reader.truncated;
+			}
+
+			if ( event == RE_CONSOLE_COMMAND ) {
+				std::string command = reader.ReadString();
+				Cmd::PushArgs( command );
+				ConsoleCommand();
+				Cmd::PopArgs();
+				continue;
+			}
+
+			int recordedNum = reader.ReadU8();
+			int clientNum = ClientSlot( recordedNum, event == RE_CONNECT );
+
+			if ( clientNum < 0 || clientNum >= level.maxclients ) {
+				Log::Warn( "replay: no slot for recorded client %d", recordedNum );
+				return false;
+			}
+
+			switch ( event ) {
+				case RE_CONNECT: {
+					lastCommandTimes[ clientNum ] = INT_MIN;
+					bool firstTime = reader.ReadU8();
+					userinfos[ clientNum ] = reader.ReadString();
+					trap_SetUserinfo( clientNum, userinfos[ clientNum ].c_str() );
+
+					if ( const char *reason = ClientConnect( clientNum, firstTime ) ) {
+						Log::Warn( "replay: client %d was denied: %s", recordedNum, reason );
+					}
+					break;
+				}
+
+				case RE_USERINFO:
+					userinfos[ clientNum ] = reader.ReadString();
+					trap_SetUserinfo( clientNum, userinfos[ clientNum ].c_str() );
+					ClientUserinfoChanged( clientNum, false );
+					break;
+
+				case RE_BEGIN:
+					ClientBegin( clientNum );
+					break;
+
+				case RE_USERCMD: {
+					usercmd_t cmd;
+
+					// a command cut off at the end of the file is dropped
+					if ( !reader.ReadBytes( &cmd, sizeof( usercmd_t ) ) ) {
+						return false;
+					}
+
+					// G_RunClient also runs the command under g_synchronousClients,
+					// only hand each recorded one to ClientThink once
+					if ( cmd.serverTime <= lastCommandTimes[ clientNum ] ) {
+						break;
+					}
+
+					lastCommandTimes[ clientNum ] = cmd.serverTime;
+					usercmds[ clientNum ] = cmd;
+					ClientThink( clientNum );
+					break;
+				}
+
+				case RE_CLIENT_COMMAND: {
+					std::string command = reader.ReadString();
+					Cmd::PushArgs( command );
+					ClientCommand( clientNum );
+					Cmd::PopArgs();
+					break;
+				}
+
+				case RE_DISCONNECT:
+					ClientDisconnect( clientNum );
+					trap_BotFreeClient( clientNum );
+					clientSlots[ recordedNum ] = -1;
+					break;
+
+				default:
+					Log::Warn( "replay: unknown event %d", Util::ordinal( event ) );
+					return false;
+			}
+		}
+
+		return false;
+	}
+
+	/**
+	 * @brief FNV-1a over the networked state of every entity and client.
+	 */
+	static uint64_t StateHash() {
+		uint64_t hash = 0xcbf29ce484222325ULL;
+
+		auto mix = [ &hash ]( const void *data, size_t size ) {
+			const uint8_t *bytes = reinterpret_cast<const uint8_t*>( data );
+
+			for ( size_t i = 0; i < size; i++ ) {
+				hash = ( hash ^ bytes[ i ] ) * 0x100000001b3ULL;
+			}
+		};
+
+		mix( &level.time, sizeof( level.time ) );
+
+		for ( int i = 0; i < level.num_entities; i++ ) {
+			const gentity_t *ent = &g_entities[ i ];
+
+			if ( !ent->inuse ) continue;
+
+			mix( &i, sizeof( i ) );
+			mix( &ent->s, sizeof( ent->s ) );
+
+			if ( ent->client && ent->client->pers.connected == CON_CONNECTED ) {
+				mix( &ent->client->ps, sizeof( ent->client->ps ) );
+			}
+		}
+
+		return hash;
+	}
+
+	void RunFrame() {
+		if ( finished ) {
+			return;
+		}
+
+		using clock = std::chrono::steady_clock;
+
+		std::vector<int> frameTimes;
+		int levelTime;
+
+		Log::Notice( "replay: running %s", replayName );
+
+		clock::time_point replayStart = clock::now();
+
+		for ( ;; ) {
+			clock::time_point frameStart = clock::now();
+
+			if ( !DispatchUntilFrame( levelTime ) ) {
+				break;
+			}
+
+			G_RunFrame( levelTime );
+
+			frameTimes.push_back( static_cast<int>( std::chrono::duration_cast<std::chrono::microseconds>(
+				clock::now() - frameStart ).count() ) );
+		}
+
+		float total = std::chrono::duration<float, std::milli>( clock::now() - replayStart ).count();
+
+		finished = true;
+
+		// nothing is left to run, the quit is queued and happens once the report is printed
+		trap_SendConsoleCommand( "quit" );
+
+		if ( reader.truncated ) {
+			Log::Warn( "replay: %s is truncated, stopped after %zu frames", replayName, frameTimes.size() );
+		}
+
+		if ( frameTimes.empty() ) {
+			Log::Warn( "replay: no frames replayed" );
+			return;
+		}
+
+		std::vector<int> sorted = frameTimes;
+		std::sort( sorted.begin(), sorted.end() );
+
+		auto percentile = [ &sorted ]( int p ) {
+			return sorted[ ( sorted.size() - 1 ) * p / 100 ] / 1000.0f;
+		};
+
+		Log::Notice( "replay: %zu frames in %.1f ms, mean %.3f ms, p50 %.3f ms, p99 %.3f ms, max %.3f ms",
+		             frameTimes.size(), total, total / frameTimes.size(),
+		             percentile( 50 ), percentile( 99 ), sorted.back() / 1000.0f );
+		Log::Notice( "replay: final state hash %016llx",
+		             static_cast<unsigned long long>( StateHash() ) );
+	}
+}
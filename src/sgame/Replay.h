@@ -0,0 +1,73 @@
+/*
+===========================================================================
+
+Unvanquished GPL Source Code
+Copyright (C) 2022 Unvanquished Developers
+
+This file is part of the Unvanquished GPL Source Code (Unvanquished Source Code).
+
+Unvanquished is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Unvanquished is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Unvanquished.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+
+#ifndef SGAME_REPLAY_H_
+#define SGAME_REPLAY_H_
+
+/*
+ * Deterministic recording and headless replay of the game module inputs.
+ *
+ * With g_replayRecord set to a file name, every input the engine feeds to the
+ * sgame for human clients is written in order: connects, userinfo changes,
+ * begins, usercmds, client commands, disconnects, console commands and frame
+ * boundaries, together with the map name and random seed.
+ *
+ * With g_replayPlay set, the engine's frames are ignored and the recorded
+ * inputs are fed back through the same entry points, back to back and as fast
+ * as possible. Bots are not recorded; they are recreated by the game itself
+ * and, like background navgen, run deterministically during a replay. At the
+ * end the driver prints per-frame timings and a hash of the final game state.
+ *
+ * Typical usage on a dedicated server:
+ *   +set g_replayRecord replays/game.rec +map plat23
+ *   +set g_replayPlay replays/game.rec +map plat23
+ */
+namespace Replay {
+	// Called from the VM entry point around G_InitGame / G_ShutdownGame.
+	// When a replay is loaded, levelTime and randomSeed are replaced by the recorded values.
+	void Init( int &levelTime, int &randomSeed );
+	void Shutdown();
+
+	bool Recording();
+	bool Playing();
+
+	// Recording hooks for the engine to game entry points.
+	void RecordConnect( int clientNum, bool firstTime );
+	void RecordUserinfoChanged( int clientNum );
+	void RecordBegin( int clientNum );
+	void RecordUsercmd( int clientNum, const usercmd_t &cmd );
+	void RecordClientCommand( int clientNum, Str::StringRef command );
+	void RecordDisconnect( int clientNum );
+	void RecordConsoleCommand();
+	void RecordFrame( int levelTime );
+
+	// Replaces the engine's frame while a replay is loaded, quits once it is done.
+	void RunFrame();
+
+	// Use these instead of the traps for anything a replay must provide.
+	void GetUsercmd( int clientNum, usercmd_t *cmd );
+	void GetUserinfo( int clientNum, char *buffer, int bufferSize );
+}
+
+#endif // SGAME_REPLAY_H_
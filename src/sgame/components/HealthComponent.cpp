@@ -22,9 +22,6 @@ void HealthComponent::HandlePrepareNetCode() {
 	gclient_t *client = entity.oldEnt->client;
 
 	if (client) {
-		if (client->ps.stats[STAT_HEALTH] != transmittedHealth) {
-			client->pers.infoChangeTime = level.time;
-		}
 		client->ps.stats[STAT_HEALTH] = transmittedHealth;
 	} else if (entity.oldEnt->s.eType == entityType_t::ET_BUILDABLE) {
 		entity.oldEnt->s.generic1 = std::max(transmittedHealth, 0);
@@ -189,9 +186,6 @@ Util::optional<glm::vec3> direction, int flags, meansOfDeath_t meansOfDeath) {
 	// Do the damage.
 	health -= take;
 
-	// Update team overlay info.
-	if (client) client->pers.infoChangeTime = level.time;
-
 	// TODO: Move lastDamageTime to HealthComponent.
 	entity.oldEnt->lastDamageTime = level.time;
 
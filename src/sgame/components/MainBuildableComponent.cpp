@@ -27,7 +27,7 @@ void MainBuildableComponent::HandleDamage(float /*amount*/, gentity_t* /*source*
 }
 
 void MainBuildableComponent::HandleDie(gentity_t* /*killer*/, meansOfDeath_t meansOfDeath) {
-	G_UpdateBuildPointBudgets();
+	G_QueueBuildPointBudgetUpdate();
 
 	if (G_IsWarnableMOD(meansOfDeath)) {
 		// TODO: Use TeamComponent.
@@ -36,7 +36,7 @@ void MainBuildableComponent::HandleDie(gentity_t* /*killer*/, meansOfDeath_t mea
 }
 
 void MainBuildableComponent::HandleFinishConstruction() {
-	G_UpdateBuildPointBudgets();
+	G_QueueBuildPointBudgetUpdate();
 
 	// TODO: Generate event that informs team here.
 }
@@ -5,6 +5,9 @@ MiningComponent::MiningComponent(Entity& entity, ThinkingComponent& r_ThinkingCo
 	: MiningComponentBase(entity, r_ThinkingComponent)
 	, active(false) {
 
+	// Cache the interference with all miners in range.
+	LinkNeighbors();
+
 	// Already calculate the predicted efficiency.
 	CalculateEfficiency();
 
@@ -12,6 +15,11 @@ MiningComponent::MiningComponent(Entity& entity, ThinkingComponent& r_ThinkingCo
 	InformNeighbors();
 }
 
+MiningComponent::~MiningComponent() {
+	// Make sure no other miner keeps a pointer to this one.
+	UnlinkNeighbors();
+}
+
 void MiningComponent::HandlePrepareNetCode() {
 	// Mining efficiency.
 	entity.oldEnt->s.weaponAnim = (int)std::round(Efficiency() * (float)0xff);
@@ -29,7 +37,7 @@ void MiningComponent::HandleFinishConstruction() {
 	InformNeighbors();
 
 	// Update both team's budgets.
-	G_UpdateBuildPointBudgets();
+	G_QueueBuildPointBudgetUpdate();
 }
 
 void MiningComponent::HandleDie(gentity_t* /*killer*/, meansOfDeath_t /*meansOfDeath*/) {
@@ -43,7 +51,7 @@ void MiningComponent::HandleDie(gentity_t* /*killer*/, meansOfDeath_t /*meansOfD
 	InformNeighbors();
 
 	// Update both team's budgets.
-	G_UpdateBuildPointBudgets();
+	G_QueueBuildPointBudgetUpdate();
 }
 
 float MiningComponent::InterferenceMod(float distance) {
@@ -87,21 +95,61 @@ MiningComponent::Efficiencies MiningComponent::FindEfficiencies(
 }
 
 void MiningComponent::CalculateEfficiency() {
-	Efficiencies efficiencies = FindEfficiencies(
-		G_Team(entity.oldEnt), VEC2GLM(entity.oldEnt->s.origin), this);
+	team_t team = G_Team(entity.oldEnt);
+	Efficiencies efficiencies{ 1.0f, 1.0f };
+
+	// Same as FindEfficiencies, but with the cached modifiers of the miners in range.
+	for (const Neighbor& neighbor : neighbors) {
+		MiningComponent& other = *neighbor.miner;
+
+		// Do not consider dead neighbours, even when predicting, as they can never become active.
+		if (!Entities::IsAlive(other.entity)) continue;
+
+		// Enemy miners under construction are a secret
+		if (!(G_Team(other.entity.oldEnt) != team && !other.active)) {
+			efficiencies.predicted *= neighbor.interferenceMod;
+		}
+
+		if (other.active) {
+			efficiencies.actual *= neighbor.interferenceMod;
+		}
+	}
+
 	currentEfficiency = active ? efficiencies.actual : 0.0f;
 	predictedEfficiency = efficiencies.predicted;
 }
 
 void MiningComponent::InformNeighbors() {
+	for (const Neighbor& neighbor : neighbors) {
+		neighbor.miner->CalculateEfficiency();
+	}
+}
+
+void MiningComponent::LinkNeighbors() {
 	ForEntities<MiningComponent>([&] (Entity& other, MiningComponent& miningComponent) {
 		if (&other == &entity) return;
-		if (G_Distance(entity.oldEnt, other.oldEnt) > RGS_RANGE * 2.0f) return;
 
-		miningComponent.CalculateEfficiency();
+		float distance = G_Distance(entity.oldEnt, other.oldEnt);
+		if (distance > RGS_RANGE * 2.0f) return;
+
+		float interferenceMod = InterferenceMod(distance);
+		neighbors.push_back({&miningComponent, interferenceMod});
+		miningComponent.neighbors.push_back({this, interferenceMod});
 	});
 }
 
+void MiningComponent::UnlinkNeighbors() {
+	for (const Neighbor& neighbor : neighbors) {
+		std::vector<Neighbor>& others = neighbor.miner->neighbors;
+
+		others.erase(std::remove_if(others.begin(), others.end(), [this](const Neighbor& other) {
+			return other.miner == this;
+		}), others.end());
+	}
+
+	neighbors.clear();
+}
+
 float MiningComponent::Efficiency(bool predict) {
 	return predict ? predictedEfficiency : currentEfficiency;
 }
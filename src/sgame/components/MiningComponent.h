@@ -18,6 +18,8 @@ class MiningComponent: public MiningComponentBase {
 		 */
 		MiningComponent(Entity& entity, ThinkingComponent& r_ThinkingComponent);
 
+		~MiningComponent();
+
 		/**
 		 * @brief Handle the PrepareNetCode message.
 		 * @note This method is an interface for autogenerated code, do not modify its signature.
@@ -70,11 +72,26 @@ class MiningComponent: public MiningComponentBase {
 		int Budget(bool predict = false);
 
 	private:
+		/**
+		 * @brief Another miner in interference range and the modifier it applies to this one.
+		 */
+		struct Neighbor {
+			MiningComponent* miner;
+			float            interferenceMod;
+		};
+
 		/**
 		 * @brief Whether the miner is currently mining (and interfering with other miners).
 		 */
 		bool active;
 
+		/**
+		 * @brief All other miners in interference range.
+		 *
+		 * Miners don't move, so the pairwise modifiers only change when a miner is added or removed.
+		 */
+		std::vector<Neighbor> neighbors;
+
 		/**
 		 * @brief Current efficiency.
 		 */
@@ -94,6 +111,16 @@ class MiningComponent: public MiningComponentBase {
 		 * @brief Adjust the rate of all other mining structures in range.
 		 */
 		void InformNeighbors();
+
+		/**
+		 * @brief Find all other miners in range and add this one to their neighbors.
+		 */
+		void LinkNeighbors();
+
+		/**
+		 * @brief Remove this miner from the neighbors of all others.
+		 */
+		void UnlinkNeighbors();
 };
 
 #endif // MINING_COMPONENT_H_
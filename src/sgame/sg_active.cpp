@@ -26,6 +26,7 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include "sg_local.h"
 #include "Entities.h"
+#include "Replay.h"
 #include "CBSE.h"
 #include "sg_cm_world.h"
 
@@ -968,6 +969,8 @@ static void ClientTimerActions( gentity_t *ent, int msec )
 
 					if ( buildable == BA_H_DRILL || buildable == BA_A_LEECH )
 					{
+						G_ApplyBuildPointBudgets();
+
 						float deltaEff = G_RGSPredictEfficiencyDelta(dummy, team);
 						int   deltaBP  = (int)(level.team[team].totalBudget + deltaEff *
 						                       g_buildPointBudgetPerMiner.Get()) -
@@ -2262,6 +2265,9 @@ static void ClientThink_real( gentity_t *self )
 		}
 	}
 
+	G_ApplyMomentumChanges();
+	G_ApplyBuildPointBudgets();
+
 	client->ps.persistant[ PERS_SPENTBUDGET ]  = level.team[client->pers.team].spentBudget;
 	client->ps.persistant[ PERS_MARKEDBUDGET ] = G_GetMarkedBudget( (team_t)client->pers.team );
 	client->ps.persistant[ PERS_TOTALBUDGET ]  = (int)level.team[client->pers.team].totalBudget;
@@ -2289,7 +2295,8 @@ void ClientThink( int clientNum )
 	gentity_t *ent;
 
 	ent = g_entities + clientNum;
-	trap_GetUsercmd( clientNum, &ent->client->pers.cmd );
+	Replay::GetUsercmd( clientNum, &ent->client->pers.cmd );
+	Replay::RecordUsercmd( clientNum, ent->client->pers.cmd );
 	if ( ent->client->pers.cmd.flags & UF_TYPING && !( ent->r.svFlags & SVF_BOT ) && Entities::IsAlive( ent ) )
 	{
 		ent->client->ps.eFlags |= EF_TYPING;
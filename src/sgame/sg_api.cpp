@@ -34,6 +34,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "sg_local.h"
 #include "sg_cm_world.h"
+#include "Replay.h"
 #include "botlib/bot_api.h"
 #include "engine/server/sg_msgdef.h"
 #include "shared/VMMain.h"
@@ -76,6 +77,7 @@ void VM::VMHandleSyscall(uint32_t id, Util::Reader reader) {
 		case GAME_INIT:
 			IPC::HandleMsg<GameInitMsg>(VM::rootChannel, std::move(reader), [](int levelTime, int randomSeed, bool cheats, bool inClient) {
 				g_cheats = cheats;
+				Replay::Init(levelTime, randomSeed);
 				G_InitGame(levelTime, randomSeed, inClient);
 			});
 			break;
@@ -83,11 +85,14 @@ void VM::VMHandleSyscall(uint32_t id, Util::Reader reader) {
 		case GAME_SHUTDOWN:
 			IPC::HandleMsg<GameShutdownMsg>(VM::rootChannel, std::move(reader), [](bool restart) {
 				G_ShutdownGame(restart);
+				Replay::Shutdown();
 			});
 			break;
 
 		case GAME_CLIENT_CONNECT:
 			IPC::HandleMsg<GameClientConnectMsg>(VM::rootChannel, std::move(reader), [](int clientNum, bool firstTime, int isBot, bool& denied, std::string& reason) {
+				if (!isBot)
+					Replay::RecordConnect(clientNum, firstTime);
 				const char* deniedStr = isBot ? ClientBotConnect(clientNum, firstTime, TEAM_NONE) : ClientConnect(clientNum, firstTime);
 				denied = deniedStr != nullptr;
 				if (denied)
@@ -103,24 +108,28 @@ void VM::VMHandleSyscall(uint32_t id, Util::Reader reader) {
 
 		case GAME_CLIENT_USERINFO_CHANGED:
 			IPC::HandleMsg<GameClientUserinfoChangedMsg>(VM::rootChannel, std::move(reader), [](int clientNum) {
+				Replay::RecordUserinfoChanged(clientNum);
 				ClientUserinfoChanged(clientNum, false);
 			});
 			break;
 
 		case GAME_CLIENT_DISCONNECT:
 			IPC::HandleMsg<GameClientDisconnectMsg>(VM::rootChannel, std::move(reader), [](int clientNum) {
+				Replay::RecordDisconnect(clientNum);
 				ClientDisconnect(clientNum);
 			});
 			break;
 
 		case GAME_CLIENT_BEGIN:
 			IPC::HandleMsg<GameClientBeginMsg>(VM::rootChannel, std::move(reader), [](int clientNum) {
+				Replay::RecordBegin(clientNum);
 				ClientBegin(clientNum);
 			});
 			break;
 
 		case GAME_CLIENT_COMMAND:
 			IPC::HandleMsg<GameClientCommandMsg>(VM::rootChannel, std::move(reader), [](int clientNum, std::string command) {
+				Replay::RecordClientCommand(clientNum, command);
 				Cmd::PushArgs(command);
 				ClientCommand(clientNum);
 				Cmd::PopArgs();
@@ -129,6 +138,11 @@ void VM::VMHandleSyscall(uint32_t id, Util::Reader reader) {
 
 		case GAME_RUN_FRAME:
 			IPC::HandleMsg<GameRunFrameMsg>(VM::rootChannel, std::move(reader), [](int levelTime) {
+				if (Replay::Playing()) {
+					Replay::RunFrame();
+					return;
+				}
+				Replay::RecordFrame(levelTime);
 				G_RunFrame(levelTime);
 			});
 			break;
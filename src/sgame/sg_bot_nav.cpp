@@ -24,6 +24,7 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 */
 
 #include "sg_bot_util.h"
+#include "Replay.h"
 #include "botlib/bot_types.h"
 #include "botlib/bot_api.h"
 #include "shared/bot_nav_shared.h"
@@ -80,6 +81,9 @@ static Cvar::Range<Cvar::Cvar<int>> msecPerFrame(
 static Cvar::Cvar<int> frameToggle("g_bot_navgen_frame", "FOR INTERNAL USE", Cvar::NONE, 0);
 static Cvar::Cvar<bool> g_bot_autocrouch("g_bot_autocrouch", "whether bots should crouch when they detect an obstacle", Cvar::NONE, true);
 
+// navgen steps per game frame while replaying, see Replay.h
+static const int REPLAY_NAVGEN_STEPS_PER_FRAME = 16;
+
 static NavmeshGenerator navgen;
 static std::vector<class_t> navgenQueue;
 static class_t generatingNow;
@@ -128,15 +132,22 @@ void G_BotBackgroundNavgen()
 	// one navgen slice per *server frame*, not per game frame. There doesn't seem to be any API
 	// for the server frame count, so put a command in the command buffer and check for the
 	// next server frame by seeing whether it has executed.
+	// A replay runs all of its frames within one server frame and must not depend on
+	// wall-clock time, so do a fixed amount of work per game frame instead.
+	int replaySteps = Replay::Playing() ? REPLAY_NAVGEN_STEPS_PER_FRAME : 0;
+
 	static int lastToggle = -12345;
-	if ( lastToggle == frameToggle.Get() )
+	if ( !replaySteps )
 	{
-		return;
+		if ( lastToggle == frameToggle.Get() )
+		{
+			return;
+		}
+		lastToggle = frameToggle.Get();
+		trap_SendConsoleCommand( "toggle g_bot_navgen_frame" );
 	}
-	lastToggle = frameToggle.Get();
-	trap_SendConsoleCommand( "toggle g_bot_navgen_frame" );
 
-	while ( Sys::Milliseconds() < stopTime )
+	while ( replaySteps ? replaySteps-- > 0 : Sys::Milliseconds() < stopTime )
 	{
 		if ( navgen.Step() )
 		{
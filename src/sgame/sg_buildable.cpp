@@ -755,6 +755,8 @@ void G_UpdateBuildablePowerStates()
 {
 	gentity_t* activeMainBuildable;
 
+	G_ApplyBuildPointBudgets();
+
 	for (team_t team = TEAM_NONE; (team = G_IterateTeams(team)); ) {
 		std::vector<Entity*> poweredBuildables;
 		std::vector<Entity*> unpoweredBuildables;
@@ -2732,8 +2734,6 @@ void G_BuildLogRevert( int id )
 
 	for ( int team = TEAM_NONE + 1; team < NUM_TEAMS; ++team )
 	{
-		G_AddMomentumGenericStep( (team_t) team, momentumChange[ team ] );
+		G_AddMomentumGeneric( (team_t) team, momentumChange[ team ] );
 	}
-
-	G_AddMomentumEnd();
 }
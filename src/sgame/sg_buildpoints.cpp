@@ -66,9 +66,28 @@ float G_RGSPredictEfficiencyDelta(vec3_t origin, team_t team) {
 }
 
 /**
- * @brief Calculate the build point budgets for both teams.
+ * @brief Whether a miner or main buildable changed since the budgets were last calculated.
  */
-void G_UpdateBuildPointBudgets() {
+static bool budgetsQueued = true;
+
+/**
+ * @brief Request the build point budgets for both teams to be recalculated.
+ *
+ * Several miners may die in one frame, so the budgets are only rebuilt once, either at the end
+ * of the frame or when they are read.
+ */
+void G_QueueBuildPointBudgetUpdate() {
+	budgetsQueued = true;
+}
+
+/**
+ * @brief Calculate the build point budgets for both teams if an update was queued.
+ */
+void G_ApplyBuildPointBudgets() {
+	if (!budgetsQueued) return;
+
+	budgetsQueued = false;
+
 	int abp = g_BPInitialBudgetAliens.Get();
 	int hbp = g_BPInitialBudgetHumans.Get();
 	for (team_t team = TEAM_NONE; (team = G_IterateTeams(team)); ) {
@@ -129,6 +148,8 @@ void G_RecoverBuildPoints() {
  */
 int G_GetFreeBudget(team_t team)
 {
+	G_ApplyBuildPointBudgets();
+
 	return (int)level.team[team].totalBudget - (level.team[team].spentBudget + level.team[team].queuedBudget);
 }
 
@@ -27,6 +27,7 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 #include "sg_local.h"
 #include "engine/qcommon/q_unicode.h"
 #include "Entities.h"
+#include "Replay.h"
 #include "CBSE.h"
 #include "sg_cm_world.h"
 
@@ -76,8 +77,6 @@ void G_AddCreditToClient( gclient_t *client, short credit, bool cap )
 
 	// Copy to ps so the client can access it
 	client->ps.persistant[ PERS_CREDIT ] = client->pers.credit;
-
-	client->pers.infoChangeTime = level.time;
 }
 
 /*
@@ -807,7 +806,7 @@ const char *ClientUserinfoChanged( int clientNum, bool forceName )
 	ent = g_entities + clientNum;
 	client = ent->client;
 
-	trap_GetUserinfo( clientNum, userinfo, sizeof( userinfo ) );
+	Replay::GetUserinfo( clientNum, userinfo, sizeof( userinfo ) );
 
 	// check for malformed or illegal info strings
 	if ( !Info_Validate( userinfo ) )
@@ -1088,7 +1087,7 @@ const char *ClientConnect( int clientNum, bool firstTime )
 	ent->client = client;
 	memset( client, 0, sizeof( *client ) );
 
-	trap_GetUserinfo( clientNum, userinfo, sizeof( userinfo ) );
+	Replay::GetUserinfo( clientNum, userinfo, sizeof( userinfo ) );
 
 	value = Info_ValueForKey( userinfo, "ip" );
 
@@ -1324,6 +1323,7 @@ void ClientBegin( int clientNum )
 
 	client->pers.connected = CON_CONNECTED;
 	client->pers.enterTime = level.time;
+	G_ResetTeamInfo( clientNum );
 
 	ClientAdminChallenge( clientNum );
 
@@ -1631,7 +1631,7 @@ void ClientSpawn( gentity_t *ent, gentity_t *spawn, const vec3_t origin, const v
 	client->ps.persistant[ PERS_SPAWN_COUNT ]++;
 	client->ps.persistant[ PERS_SPECSTATE ] = client->sess.spectatorState;
 
-	trap_GetUserinfo( index, userinfo, sizeof( userinfo ) );
+	Replay::GetUserinfo( index, userinfo, sizeof( userinfo ) );
 	client->ps.eFlags = flags;
 
 	ent->s.groundEntityNum = ENTITYNUM_NONE;
@@ -1741,7 +1741,7 @@ void ClientSpawn( gentity_t *ent, gentity_t *spawn, const vec3_t origin, const v
 	// the respawned flag will be cleared after the attack and jump keys come up
 	client->ps.pm_flags |= PMF_RESPAWNED;
 
-	trap_GetUsercmd( client->num(), &ent->client->pers.cmd );
+	Replay::GetUsercmd( client->num(), &ent->client->pers.cmd );
 	G_SetClientViewAngle( ent, spawn_angles );
 
 	if ( client->sess.spectatorState == SPECTATOR_NOT )
@@ -1829,8 +1829,6 @@ void ClientSpawn( gentity_t *ent, gentity_t *spawn, const vec3_t origin, const v
 	// clear entity state values
 	BG_PlayerStateToEntityState( &client->ps, &ent->s, true );
 
-	client->pers.infoChangeTime = level.time;
-
 	// (re)tag the client for its team
 	Beacon::DeleteTags( ent );
 	Beacon::Tag( ent, (team_t)ent->client->ps.persistant[ PERS_TEAM ], true );
@@ -663,6 +663,7 @@ static void Cmd_Give_f( gentity_t *ent )
 		{
 			valid = true;
 			G_AddMomentumGeneric( team, amount );
+			G_ApplyMomentumChanges();
 		}
 	}
 
@@ -674,6 +675,7 @@ static void Cmd_Give_f( gentity_t *ent )
 		{
 			valid = true;
 
+			G_ApplyBuildPointBudgets();
 			level.team[ent->client->pers.team].totalBudget +=
 				static_cast<int>( amount );
 		}
@@ -2180,6 +2182,9 @@ static void Cmd_Class_f( gentity_t *ent )
 static void Cmd_ClientReady_f( gentity_t *ent )
 {
 	G_SendClientPmoveParams( ent->num() );
+
+	// the cgame was (re)started and lost the team overlay
+	G_ResetTeamInfo( ent->num() );
 }
 
 static void Cmd_Deconstruct_f( gentity_t *ent )
@@ -2622,7 +2627,6 @@ static void Cmd_Sell_f( gentity_t *ent )
 	if ( updated )
 	{
 		ClientUserinfoChanged( ent->client->ps.clientNum, false );
-		ent->client->pers.infoChangeTime = level.time;
 	}
 }
 
@@ -2908,7 +2912,6 @@ static void Cmd_Buy_f( gentity_t *ent )
 	if ( updated )
 	{
 		ClientUserinfoChanged( ent->client->ps.clientNum, false );
-		ent->client->pers.infoChangeTime = level.time;
 	}
 }
 
@@ -301,7 +301,7 @@ void G_RewardAttackers( gentity_t *self )
 			G_AddCreditToClient( player->client, static_cast<short>( reward * g_rewardDestruction.Get() ), true );
 
 			// Add momentum
-			G_AddMomentumForDestroyingStep( self, player, reward );
+			G_AddMomentumForDestroying( self, player, reward );
 		}
 		else
 		{
@@ -312,12 +312,9 @@ void G_RewardAttackers( gentity_t *self )
 			G_AddCreditToClient( player->client, ( short )reward, true );
 
 			// Add momentum
-			G_AddMomentumForKillingStep( self, player, share );
+			G_AddMomentumForKilling( self, player, share );
 		}
 	}
-
-	// Complete momentum modification
-	G_AddMomentumEnd();
 }
 
 void G_PlayerDie( gentity_t *self, gentity_t *inflictor, gentity_t *attacker, int meansOfDeath )
@@ -584,8 +581,6 @@ void G_PlayerDie( gentity_t *self, gentity_t *inflictor, gentity_t *attacker, in
 	Beacon::DetachTags( self );
 
 	trap_LinkEntity( self );
-
-	self->client->pers.infoChangeTime = level.time;
 }
 
 static int ParseDmgScript( damageRegion_t *regions, const char *buf )
@@ -27,6 +27,7 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 #include "sg_local.h"
 #include "shared/parse.h"
 #include "Entities.h"
+#include "Profiler.h"
 #include "CBSE.h"
 #include "backend/CBSEBackend.h"
 #include "botlib/bot_api.h"
@@ -68,6 +69,7 @@ Cvar::Cvar<bool> g_doWarmup("g_doWarmup", "whether to enable warmup period (g_wa
 Cvar::Cvar<bool> g_lockTeamsAtStart("g_lockTeamsAtStart", "(internal use) lock teams at start of match", Cvar::NONE, false);
 Cvar::Cvar<std::string> g_logFile("g_logFile", "sgame log file, relative to <homepath>/game/", Cvar::NONE, "games.log");
 Cvar::Cvar<int> g_logGameplayStatsFrequency("g_logGameplayStatsFrequency", "log gameplay stats every x seconds", Cvar::NONE, 10);
+Cvar::Cvar<bool> g_logGameplayStatsBinary("g_logGameplayStatsBinary", "log gameplay stats as a binary stream instead of text", Cvar::NONE, false);
 Cvar::Cvar<bool> g_logFileSync("g_logFileSync", "flush g_logFile on every write", Cvar::NONE, false);
 Cvar::Cvar<bool> g_allowVote("g_allowVote", "whether votes of any kind are allowed", Cvar::NONE, true);
 Cvar::Cvar<int> g_voteLimit("g_voteLimit", "max votes per player per round", Cvar::NONE, 5);
@@ -105,7 +107,7 @@ Cvar::Callback<Cvar::Cvar<int>> g_buildPointInitialBudget(
 		Cvar::SERVERINFO,
 		DEFAULT_BP_INITIAL_BUDGET,
 		[](int) {
-			G_UpdateBuildPointBudgets();
+			G_QueueBuildPointBudgetUpdate();
 		});
 Cvar::Callback<Cvar::Cvar<int>> g_BPInitialBudgetHumans(
 		"g_BPInitialBudgetHumans",
@@ -113,7 +115,7 @@ Cvar::Callback<Cvar::Cvar<int>> g_BPInitialBudgetHumans(
 		Cvar::SERVERINFO,
 		-1,
 		[](int) {
-			G_UpdateBuildPointBudgets();
+			G_QueueBuildPointBudgetUpdate();
 		});
 Cvar::Callback<Cvar::Cvar<int>> g_BPInitialBudgetAliens(
 		"g_BPInitialBudgetAliens",
@@ -121,7 +123,7 @@ Cvar::Callback<Cvar::Cvar<int>> g_BPInitialBudgetAliens(
 		Cvar::SERVERINFO,
 		-1,
 		[](int) {
-			G_UpdateBuildPointBudgets();
+			G_QueueBuildPointBudgetUpdate();
 		});
 Cvar::Callback<Cvar::Cvar<int>> g_buildPointBudgetPerMiner(
 		"g_BPBudgetPerMiner",
@@ -129,7 +131,7 @@ Cvar::Callback<Cvar::Cvar<int>> g_buildPointBudgetPerMiner(
 		Cvar::SERVERINFO,
 		DEFAULT_BP_BUDGET_PER_MINER,
 		[](int) {
-			G_UpdateBuildPointBudgets();
+			G_QueueBuildPointBudgetUpdate();
 		});
 Cvar::Cvar<int> g_buildPointRecoveryInitialRate(
 		"g_BPRecoveryInitialRate",
@@ -505,20 +507,34 @@ void G_InitGame( int levelTime, int randomSeed, bool inClient )
 		trap_Cvar_VariableStringBuffer( "mapname", mapname, sizeof( mapname ) );
 
 		Com_sprintf( logfile, sizeof( logfile ),
-		             "stats/gameplay/%04i%02i%02i_%02i%02i%02i_%s.log",
+		             "stats/gameplay/%04i%02i%02i_%02i%02i%02i_%s.%s",
 		             1900 + qt.tm_year, qt.tm_mon + 1, qt.tm_mday,
 		             qt.tm_hour, qt.tm_min, qt.tm_sec,
-		             mapname );
+		             mapname, g_logGameplayStatsBinary.Get() ? "stats" : "log" );
 
-		trap_FS_FOpenFile( logfile, &level.logGameplayFile, fsMode_t::FS_WRITE );
-
-		if ( !level.logGameplayFile )
+		if ( g_logGameplayStatsBinary.Get() )
 		{
-			Log::Warn("Couldn't open gameplay statistics logfile: %s", logfile );
+			if ( !GameplayStats::Open( logfile ) )
+			{
+				Log::Warn("Couldn't open gameplay statistics stream: %s", logfile );
+			}
+			else
+			{
+				G_LogGameplayStats( LOG_GAMEPLAY_STATS_HEADER );
+			}
 		}
 		else
 		{
-			G_LogGameplayStats( LOG_GAMEPLAY_STATS_HEADER );
+			trap_FS_FOpenFile( logfile, &level.logGameplayFile, fsMode_t::FS_WRITE );
+
+			if ( !level.logGameplayFile )
+			{
+				Log::Warn("Couldn't open gameplay statistics logfile: %s", logfile );
+			}
+			else
+			{
+				G_LogGameplayStats( LOG_GAMEPLAY_STATS_HEADER );
+			}
 		}
 	}
 
@@ -644,7 +660,9 @@ void G_InitGame( int levelTime, int randomSeed, bool inClient )
 	G_notify_sensor_start();
 
 	// Initialize build point counts for the intial layout.
-	G_UpdateBuildPointBudgets();
+	G_QueueBuildPointBudgetUpdate();
+	G_ApplyBuildPointBudgets();
+	G_ApplyMomentumChanges();
 }
 
 /*
@@ -719,6 +737,12 @@ void G_ShutdownGame( int /* restart */ )
 		level.logGameplayFile = 0;
 	}
 
+	if ( GameplayStats::IsOpen() )
+	{
+		G_LogGameplayStats( LOG_GAMEPLAY_STATS_FOOTER );
+		GameplayStats::Close();
+	}
+
 	// write all the client session data so we can get it back
 	G_WriteSessionData();
 
@@ -1611,6 +1635,34 @@ static void G_LogGameplayStats( int state )
 
 	static int nextCalculation = 0;
 
+	if ( GameplayStats::IsOpen() )
+	{
+		switch ( state )
+		{
+			case LOG_GAMEPLAY_STATS_HEADER:
+				GameplayStats::WriteHeader();
+				nextCalculation = 0;
+				break;
+
+			case LOG_GAMEPLAY_STATS_BODY:
+				if ( level.time < nextCalculation )
+				{
+					return;
+				}
+
+				GameplayStats::WriteSample();
+				nextCalculation = level.time + std::max( 1, g_logGameplayStatsFrequency.Get() ) * 1000;
+				break;
+
+			case LOG_GAMEPLAY_STATS_FOOTER:
+				GameplayStats::WriteFooter();
+				nextCalculation = 0;
+				break;
+		}
+
+		return;
+	}
+
 	if ( !level.logGameplayFile )
 	{
 		return;
@@ -2150,6 +2202,9 @@ void G_RunFrame( int levelTime )
 
 		CheckExitRules();
 
+		G_ApplyMomentumChanges();
+		G_ApplyBuildPointBudgets();
+
 		return;
 	}
 
@@ -2194,6 +2249,10 @@ void G_RunFrame( int levelTime )
 			level.pausedTime = 0;
 		}
 
+		// admin and client commands still run while paused
+		G_ApplyMomentumChanges();
+		G_ApplyBuildPointBudgets();
+
 		return;
 	}
 
@@ -2211,99 +2270,120 @@ void G_RunFrame( int levelTime )
 
 	G_CheckPmoveParamChanges();
 
+	Profiler::BeginFrame( levelTime );
+
 	// go through all allocated objects
-	ent = &g_entities[ 0 ];
-	for ( i = 0; i < level.num_entities; i++, ent++ )
 	{
-		if ( !ent->inuse ) continue;
+		G_PROFILE_ZONE( ZONE_ENTITIES );
 
-		// clear events that are too old
-		if ( level.time - ent->eventTime > EVENT_VALID_MSEC )
+		ent = &g_entities[ 0 ];
+		for ( i = 0; i < level.num_entities; i++, ent++ )
 		{
-			if ( ent->s.event )
-			{
-				ent->s.event = 0; // &= EV_EVENT_BITS;
+			if ( !ent->inuse ) continue;
 
-				if ( ent->client )
+			// clear events that are too old
+			if ( level.time - ent->eventTime > EVENT_VALID_MSEC )
+			{
+				if ( ent->s.event )
 				{
-					ent->client->ps.externalEvent = 0;
-					//ent->client->ps.events[0] = 0;
-					//ent->client->ps.events[1] = 0;
+					ent->s.event = 0; // &= EV_EVENT_BITS;
+
+					if ( ent->client )
+					{
+						ent->client->ps.externalEvent = 0;
+						//ent->client->ps.events[0] = 0;
+						//ent->client->ps.events[1] = 0;
+					}
 				}
-			}
 
-			if ( ent->freeAfterEvent )
-			{
-				// tempEntities or dropped items completely go away after their event
-				G_FreeEntity( ent );
-				continue;
+				if ( ent->freeAfterEvent )
+				{
+					// tempEntities or dropped items completely go away after their event
+					G_FreeEntity( ent );
+					continue;
+				}
 			}
-		}
-
-		// temporary entities or ones about to be removed don't think
-		if ( ent->freeAfterEvent ) continue;
-
-		// calculate the acceleration of this entity
-		if ( ent->evaluateAcceleration ) G_EvaluateAcceleration( ent, msec );
-
-		// think/run entity by type
-		switch ( ent->s.eType )
-		{
-			case entityType_t::ET_MISSILE:
-				G_RunMissile( ent );
-				continue;
 
-			case entityType_t::ET_BUILDABLE:
-				// TODO: Do buildables make any use of G_Physics' functionality apart from the call
-				//       to G_RunThink?
-				G_Physics( ent );
-				continue;
+			// temporary entities or ones about to be removed don't think
+			if ( ent->freeAfterEvent ) continue;
 
-			case entityType_t::ET_CORPSE:
-				G_Physics( ent );
-				continue;
+			// calculate the acceleration of this entity
+			if ( ent->evaluateAcceleration ) G_EvaluateAcceleration( ent, msec );
 
-			case entityType_t::ET_MOVER:
-				G_RunMover( ent );
-				continue;
+			// think/run entity by type
+			switch ( ent->s.eType )
+			{
+				case entityType_t::ET_MISSILE:
+				{
+					G_PROFILE_ZONE( ZONE_RUN_MISSILE );
+					G_RunMissile( ent );
+					continue;
+				}
 
-			default:
-				if ( ent->physicsObject )
+				case entityType_t::ET_BUILDABLE:
 				{
+					// TODO: Do buildables make any use of G_Physics' functionality apart from the call
+					//       to G_RunThink?
+					G_PROFILE_ZONE( ZONE_RUN_BUILDABLE );
 					G_Physics( ent );
 					continue;
 				}
-				else if ( i < MAX_CLIENTS )
+
+				case entityType_t::ET_CORPSE:
 				{
-					G_RunClient( ent );
+					G_PROFILE_ZONE( ZONE_RUN_CORPSE );
+					G_Physics( ent );
 					continue;
 				}
-				else
+
+				case entityType_t::ET_MOVER:
 				{
-					G_RunThink( ent );
+					G_PROFILE_ZONE( ZONE_RUN_MOVER );
+					G_RunMover( ent );
+					continue;
+				}
 
-					// allow entities to free themselves before acting
-					if ( ent->inuse )
+				default:
+					if ( ent->physicsObject )
 					{
-						// TODO: Is this even used/necessary?
-						//       Why do only randomly chose entities do this?
-						G_RunAct( ent );
+						G_PROFILE_ZONE( ZONE_RUN_PHYSICS );
+						G_Physics( ent );
+						continue;
 					}
-				}
+					else if ( i < MAX_CLIENTS )
+					{
+						G_PROFILE_ZONE( ZONE_RUN_CLIENT );
+						G_RunClient( ent );
+						continue;
+					}
+					else
+					{
+						G_PROFILE_ZONE( ZONE_RUN_THINK );
+						G_RunThink( ent );
+
+						// allow entities to free themselves before acting
+						if ( ent->inuse )
+						{
+							// TODO: Is this even used/necessary?
+							//       Why do only randomly chose entities do this?
+							G_RunAct( ent );
+						}
+					}
+			}
 		}
-	}
 
-	// ThinkingComponent should have been called already but who knows maybe we forgot some.
-	ForEntities<ThinkingComponent>([](Entity& entity, ThinkingComponent& thinkingComponent) {
-		// A newly created entity can randomly run things, or not, in the above loop over
-		// entities depending on whether it was added in a hole in g_entities or at the end, so
-		// ignore the entity if it was created this frame.
-		if (entity.oldEnt->creationTime != level.time && thinkingComponent.GetLastThinkTime() != level.time
-			&& !entity.oldEnt->freeAfterEvent) {
-			Log::Warn("ThinkingComponent was not called");
-			thinkingComponent.Think();
-		}
-	});
+		// ThinkingComponent should have been called already but who knows maybe we forgot some.
+		ForEntities<ThinkingComponent>([](Entity& entity, ThinkingComponent& thinkingComponent) {
+			// A newly created entity can randomly run things, or not, in the above loop over
+			// entities depending on whether it was added in a hole in g_entities or at the end, so
+			// ignore the entity if it was created this frame.
+			if (entity.oldEnt->creationTime != level.time && thinkingComponent.GetLastThinkTime() != level.time
+				&& !entity.oldEnt->freeAfterEvent) {
+				Log::Warn("ThinkingComponent was not called");
+				thinkingComponent.Think();
+			}
+		});
+	}
 
 	// perform final fixups on the players
 	ent = &g_entities[ 0 ];
@@ -2312,39 +2392,88 @@ void G_RunFrame( int levelTime )
 	{
 		if ( ent->inuse )
 		{
+			G_PROFILE_ZONE( ZONE_CLIENT_END_FRAME );
 			ClientEndFrame( ent );
 		}
 	}
 
 	// save position information for all active clients
-	G_UnlaggedStore();
+	{
+		G_PROFILE_ZONE( ZONE_UNLAGGED_STORE );
+		G_UnlaggedStore();
+	}
 
 	// Check if a build point can be removed from the queue.
-	G_RecoverBuildPoints();
+	{
+		G_PROFILE_ZONE( ZONE_RECOVER_BUILD_POINTS );
+		G_RecoverBuildPoints();
+	}
 
 	// Power down buildables if there is a budget deficit.
-	G_UpdateBuildablePowerStates();
+	{
+		G_PROFILE_ZONE( ZONE_BUILDABLE_POWER_STATES );
+		G_UpdateBuildablePowerStates();
+	}
+
+	{
+		G_PROFILE_ZONE( ZONE_DECREASE_MOMENTUM );
+		G_DecreaseMomentum();
+	}
+
+	// Let clients and sensors know about this frame's momentum and budget changes.
+	{
+		G_PROFILE_ZONE( ZONE_TEAM_JOURNAL );
+		G_ApplyMomentumChanges();
+		G_ApplyBuildPointBudgets();
+	}
 
-	G_DecreaseMomentum();
 	G_CalculateAvgPlayers();
-	G_SpawnClients( TEAM_ALIENS );
-	G_SpawnClients( TEAM_HUMANS );
-	G_UpdateZaps( msec );
-	Beacon::Frame( );
 
-	G_PrepareEntityNetCode();
+	{
+		G_PROFILE_ZONE( ZONE_SPAWN_CLIENTS );
+		G_SpawnClients( TEAM_ALIENS );
+		G_SpawnClients( TEAM_HUMANS );
+	}
+
+	{
+		G_PROFILE_ZONE( ZONE_UPDATE_ZAPS );
+		G_UpdateZaps( msec );
+	}
+
+	{
+		G_PROFILE_ZONE( ZONE_BEACONS );
+		Beacon::Frame( );
+	}
+
+	{
+		G_PROFILE_ZONE( ZONE_ENTITY_NETCODE );
+		G_PrepareEntityNetCode();
+	}
 
 	// log gameplay statistics
-	G_LogGameplayStats( LOG_GAMEPLAY_STATS_BODY );
+	{
+		G_PROFILE_ZONE( ZONE_GAMEPLAY_STATS );
+		G_LogGameplayStats( LOG_GAMEPLAY_STATS_BODY );
+	}
 
 	// see if it is time to end the level
 	CheckExitRules();
 
-	G_BotBackgroundNavgen();
-	G_BotFill( false );
+	{
+		G_PROFILE_ZONE( ZONE_BOT_NAVGEN );
+		G_BotBackgroundNavgen();
+	}
+
+	{
+		G_PROFILE_ZONE( ZONE_BOT_FILL );
+		G_BotFill( false );
+	}
 
 	// update to team status?
-	CheckTeamStatus();
+	{
+		G_PROFILE_ZONE( ZONE_TEAM_STATUS );
+		CheckTeamStatus();
+	}
 
 	// cancel vote if timed out
 	for ( i = 0; i < NUM_TEAMS; i++ )
@@ -2353,7 +2482,13 @@ void G_RunFrame( int levelTime )
 	}
 
 	BotDebugDrawMesh();
-	G_BotUpdateObstacles();
+
+	{
+		G_PROFILE_ZONE( ZONE_BOT_OBSTACLES );
+		G_BotUpdateObstacles();
+	}
+
+	Profiler::EndFrame();
 }
 
 void G_PrepareEntityNetCode() {
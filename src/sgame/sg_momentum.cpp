@@ -64,20 +64,55 @@ static const char *MomentumTypeToReason( momentum_t type )
 }
 
 /**
- * Has to be called whenever the momentum of a team has been modified.
+ * Momentum changes made since the last G_ApplyMomentumChanges.
+ *
+ * Kills, destructions and the periodic decrease can change a team's momentum many times per
+ * frame. Clients, unlockables and legacy stage sensors only need to know about the net change,
+ * so they are updated once at the end of the frame.
+ */
+static struct
+{
+	bool  pending;
+	float baseMomentum[ NUM_TEAMS ]; // momentum before the first change of the frame
+} journal;
+
+/**
+ * Has to be called before the momentum of a team is modified.
+ */
+static void JournalMomentumChange()
+{
+	if ( journal.pending )
+	{
+		return;
+	}
+
+	for ( int team = TEAM_NONE + 1; team < NUM_TEAMS; team++ )
+	{
+		journal.baseMomentum[ team ] = level.team[ team ].momentum;
+	}
+
+	journal.pending = true;
+}
+
+/**
+ * Sends the momentum of every team to its clients and updates the unlockables.
  */
 static void MomentumChanged()
 {
+	short     momentum[ NUM_TEAMS ];
 	int       playerNum;
-	gentity_t *player;
 	gclient_t *client;
 	team_t    team;
 
+	for ( team = TEAM_NONE; ( team = G_IterateTeams( team ) ); )
+	{
+		momentum[ team ] = ( short )( level.team[ team ].momentum * 10.0f + 0.5f );
+	}
+
 	// send to clients
 	for ( playerNum = 0; playerNum < level.maxclients; playerNum++ )
 	{
-		player = &g_entities[ playerNum ];
-		client = player->client;
+		client = g_entities[ playerNum ].client;
 
 		if ( !client )
 		{
@@ -88,8 +123,7 @@ static void MomentumChanged()
 
 		if ( team > TEAM_NONE && team < NUM_TEAMS )
 		{
-			client->ps.persistant[ PERS_MOMENTUM ] = ( short )
-				( level.team[ team ].momentum * 10.0f + 0.5f );
+			client->ps.persistant[ PERS_MOMENTUM ] = momentum[ team ];
 		}
 	}
 
@@ -215,8 +249,7 @@ static float MomentumMod( momentum_t type )
  *
  * Will notify the client who earned it if given, otherwise the whole team, with an event.
  */
-static float AddMomentum( momentum_t type, team_t team, float amount,
-                            gentity_t *source, bool skipChangeHook )
+static float AddMomentum( momentum_t type, team_t team, float amount, gentity_t *source )
 {
 	gentity_t *event = nullptr;
 	gclient_t *client;
@@ -235,15 +268,10 @@ static float AddMomentum( momentum_t type, team_t team, float amount,
 
 	if ( amount != 0.0f )
 	{
-		// add momentum to team
+		// add momentum to team, the rest of the game learns about it at the end of the frame
+		JournalMomentumChange();
 		level.team[ team ].momentum += amount;
 
-		// run change hook if requested
-		if ( !skipChangeHook )
-		{
-			MomentumChanged();
-		}
-
 		// notify source
 		if ( source )
 		{
@@ -270,9 +298,6 @@ static float AddMomentum( momentum_t type, team_t team, float amount,
 			event->s.otherEntityNum2 = ( int )( fabs( amount ) * 10.0f + 0.5f );
 			event->s.groundEntityNum = amount < 0.0f;
 		}
-
-		// notify legacy stage sensors
-		NotifyLegacyStageSensors( team, amount );
 	}
 
 	if ( g_debugMomentum.Get() > 0 )
@@ -330,39 +355,51 @@ void G_DecreaseMomentum()
 	}
 
 	// decrease momentum
+	JournalMomentumChange();
+
 	for ( team = TEAM_NONE + 1; team < NUM_TEAMS; team++ )
 	{
 		amount = level.team[ team ].momentum * ( decreaseFactor - 1.0f );
 
 		level.team[ team ].momentum += amount;
-
-		// notify legacy stage sensors
-		NotifyLegacyStageSensors( (team_t) team, amount );
 	}
 
-	MomentumChanged();
-
 	nextCalculation = level.time + DECREASE_MOMENTUM_PERIOD;
 }
 
 /**
- * Adds momentum.
+ * Notifies clients, unlockables and legacy stage sensors of the net momentum change since the
+ * last call. Called at the end of every frame, including paused ones, and wherever the build
+ * point budgets are applied, so that no change waits for the next frame.
  */
-float G_AddMomentumGeneric( team_t team, float amount )
+void G_ApplyMomentumChanges()
 {
-	AddMomentum( CONF_GENERIC, team, amount, nullptr, false );
+	if ( !journal.pending )
+	{
+		return;
+	}
 
-	return amount;
+	journal.pending = false;
+
+	for ( team_t team = TEAM_NONE; ( team = G_IterateTeams( team ) ); )
+	{
+		float amount = level.team[ team ].momentum - journal.baseMomentum[ team ];
+
+		if ( amount != 0.0f )
+		{
+			NotifyLegacyStageSensors( team, amount );
+		}
+	}
+
+	MomentumChanged();
 }
 
 /**
  * Adds momentum.
- *
- * G_AddMomentumEnd has to be called after all G_AddMomentum*Step steps are done.
  */
-float G_AddMomentumGenericStep( team_t team, float amount )
+float G_AddMomentumGeneric( team_t team, float amount )
 {
-	AddMomentum( CONF_GENERIC, team, amount, nullptr, true );
+	AddMomentum( CONF_GENERIC, team, amount, nullptr );
 
 	return amount;
 }
@@ -411,7 +448,7 @@ float G_AddMomentumForBuilding( gentity_t *buildable )
 		builder = nullptr;
 	}
 
-	reward = AddMomentum( CONF_BUILDING, team, value, builder, false );
+	reward = AddMomentum( CONF_BUILDING, team, value, builder );
 
 	// Save reward with buildable so it can be reverted
 	buildable->momentumEarned = reward;
@@ -447,15 +484,13 @@ float G_RemoveMomentumForDecon( gentity_t *buildable, gentity_t *deconner )
 	// Remove only partial momentum as the lost health fraction awards momentum to the enemy.
 	value *= Entities::HealthFraction(buildable);
 
-	return AddMomentum( CONF_DECONSTRUCTING, team, -value, deconner, false );
+	return AddMomentum( CONF_DECONSTRUCTING, team, -value, deconner );
 }
 
 /**
  * Adds momentum for destroying a buildable.
- *
- * G_AddMomentumEnd has to be called after all G_AddMomentum*Step steps are done.
  */
-float G_AddMomentumForDestroyingStep( gentity_t *buildable, gentity_t *attacker, float amount )
+float G_AddMomentumForDestroying( gentity_t *buildable, gentity_t *attacker, float amount )
 {
 	team_t team;
 
@@ -473,15 +508,13 @@ float G_AddMomentumForDestroyingStep( gentity_t *buildable, gentity_t *attacker,
 
 	team = (team_t) attacker->client->pers.team;
 
-	return AddMomentum( CONF_DESTROYING, team, amount, attacker, true );
+	return AddMomentum( CONF_DESTROYING, team, amount, attacker );
 }
 
 /**
  * Adds momentum for killing a player.
- *
- * G_AddMomentumEnd has to be called after all G_AddMomentum*Step steps are done.
  */
-float G_AddMomentumForKillingStep( gentity_t *victim, gentity_t *attacker, float share )
+float G_AddMomentumForKilling( gentity_t *victim, gentity_t *attacker, float share )
 {
 	float  value;
 	team_t team;
@@ -501,13 +534,5 @@ float G_AddMomentumForKillingStep( gentity_t *victim, gentity_t *attacker, float
 	value = BG_GetPlayerValue( victim->client->ps ) * MOMENTUM_PER_CREDIT * share;
 	team  = (team_t) attacker->client->pers.team;
 
-	return AddMomentum( CONF_KILLING, team, value, attacker, true );
-}
-
-/**
- * Has to be called after the last G_AddMomentum*Step step.
- */
-void G_AddMomentumEnd()
-{
-	MomentumChanged();
+	return AddMomentum( CONF_KILLING, team, value, attacker );
 }
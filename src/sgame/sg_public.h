@@ -109,7 +109,8 @@ void ABarricade_Shrink( gentity_t *self, bool shrink );
 
 // sg_buildpoints
 float             G_RGSPredictEfficiencyDelta(vec3_t origin, team_t team);
-void              G_UpdateBuildPointBudgets();
+void              G_QueueBuildPointBudgetUpdate();
+void              G_ApplyBuildPointBudgets();
 void              G_RecoverBuildPoints();
 int               G_GetFreeBudget(team_t team);
 int               G_GetMarkedBudget(team_t team);
@@ -139,6 +140,16 @@ void              ClientDisconnect( int clientNum );
 void              ClientBegin( int clientNum );
 void              ClientAdminChallenge( int clientNum );
 
+// GameplayStats.cpp
+namespace GameplayStats {
+	bool Open( const char *fileName );
+	bool IsOpen();
+	void Close();
+	void WriteHeader();
+	void WriteSample();
+	void WriteFooter();
+}
+
 // sg_clustering.c
 namespace BaseClustering {
 	void Init();
@@ -189,14 +200,13 @@ void              G_PlayerDie( gentity_t *self, gentity_t *inflictor, gentity_t
 
 // sg_momentum.c
 void              G_DecreaseMomentum();
+void              G_ApplyMomentumChanges();
 float             G_AddMomentumGeneric( team_t team, float amount );
-float             G_AddMomentumGenericStep( team_t team, float amount );
 float             G_PredictMomentumForBuilding( gentity_t *buildable );
 float             G_AddMomentumForBuilding( gentity_t *buildable );
 float             G_RemoveMomentumForDecon( gentity_t *buildable, gentity_t *deconner );
-float             G_AddMomentumForKillingStep( gentity_t *victim, gentity_t *attacker, float share );
-float             G_AddMomentumForDestroyingStep( gentity_t *buildable, gentity_t *attacker, float amount );
-void              G_AddMomentumEnd();
+float             G_AddMomentumForKilling( gentity_t *victim, gentity_t *attacker, float share );
+float             G_AddMomentumForDestroying( gentity_t *buildable, gentity_t *attacker, float amount );
 
 // sg_main.c
 void              G_InitSpawnQueue( spawnQueue_t *sq );
@@ -277,6 +287,7 @@ bool              G_OnSameTeam( const gentity_t *ent1, const gentity_t *ent2 );
 void              G_LeaveTeam( gentity_t *self );
 void              G_ChangeTeam( gentity_t *ent, team_t newTeam );
 gentity_t         *GetCloseLocationEntity( gentity_t *ent );
+void              G_ResetTeamInfo( int clientNum );
 void              TeamplayInfoMessage( gentity_t *ent );
 int               G_PlayerCountForBalance( team_t team );
 void              CheckTeamStatus();
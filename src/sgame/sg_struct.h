@@ -549,9 +549,6 @@ struct clientPersistant_t
 	int      pubkey_authenticated; // -1 = does not have pubkey, 0 = not authenticated, 1 = authenticated
 	int      pubkey_challengedAt; // time at which challenge was sent
 
-	// level.time when teamoverlay info changed so we know to tell other players.
-	int                 infoChangeTime;
-
 	// warnings in the ban log
 	bool            hasWarnings;
 
@@ -35,6 +35,8 @@ Maryland 20850 USA.
 // this file holds commands that can be executed by the server console, but not remote clients
 
 #include "sg_local.h"
+#include "Profiler.h"
+#include "Replay.h"
 
 #define IS_NON_NULL_VEC3(vec3tor) (vec3tor[0] || vec3tor[1] || vec3tor[2])
 
@@ -701,6 +703,45 @@ static void Svcmd_PrintQueue_f()
 	}
 }
 
+/*
+===================
+Svcmd_ProfileDump_f
+
+profileDump [<frames> [<file>]]
+===================
+*/
+static void Svcmd_ProfileDump_f()
+{
+	char arg[ MAX_QPATH ];
+	int  frames = 0;
+
+	if ( trap_Argc() > 3 )
+	{
+		Log::Notice( "usage: profileDump [<frames> [<file>]]" );
+		return;
+	}
+
+	if ( trap_Argc() > 1 )
+	{
+		trap_Argv( 1, arg, sizeof( arg ) );
+		frames = atoi( arg );
+	}
+
+	Profiler::PrintSummary( frames );
+
+	if ( trap_Argc() > 2 )
+	{
+		trap_Argv( 2, arg, sizeof( arg ) );
+
+		int written = Profiler::WriteTrace( arg, frames );
+
+		if ( written )
+		{
+			Log::Notice( "wrote %d frames of Chrome trace to %s", written, arg );
+		}
+	}
+}
+
 // dumb wrapper for "a", "m", "chat", and "say"
 static void Svcmd_MessageWrapper()
 {
@@ -769,6 +810,7 @@ static const struct svcmd
 	{ "mapRotation",        false, Svcmd_MapRotation_f          },
 	{ "pr",                 false, Svcmd_Pr_f                   },
 	{ "printqueue",         false, Svcmd_PrintQueue_f           },
+	{ "profileDump",        false, Svcmd_ProfileDump_f          },
 	{ "say",                true,  Svcmd_MessageWrapper         },
 	{ "say_team",           true,  Svcmd_TeamMessage_f          },
 	{ "stopMapRotation",    false, G_StopMapRotation            },
@@ -787,6 +829,8 @@ bool  ConsoleCommand()
 
 	trap_Argv( 0, cmd, sizeof( cmd ) );
 
+	Replay::RecordConsoleCommand();
+
 	command = (struct svcmd*) bsearch( cmd, svcmds, ARRAY_LEN( svcmds ),
 	                   sizeof( struct svcmd ), cmdcmp );
 
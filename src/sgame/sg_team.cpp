@@ -369,26 +369,117 @@ gentity_t *GetCloseLocationEntity( gentity_t *ent )
 
 /*---------------------------------------------------------------------------*/
 
+// last team overlay values sent to a client about one of its teammates
+struct teamInfoEntry_t
+{
+	bool      valid;
+	int       enterTime; // to tell apart players reusing a client slot
+	team_t    team;
+	int       location;
+	int       health;
+	int       weaponClass;
+	int       credit;
+	upgrade_t upgrade;
+};
+
+// what every client was last sent, reliable commands arrive in order so this is what they have
+static struct
+{
+	int             sentTime; // pers.teamInfo after the last update, a mismatch means a full resend
+	team_t          team;
+	teamInfoEntry_t entries[ MAX_CLIENTS ];
+} teamInfoSent[ MAX_CLIENTS ];
+
+/*
+==================
+G_TeamInfoEntry
+
+Current team overlay values of a player
+==================
+*/
+static void G_TeamInfoEntry( gentity_t *player, teamInfoEntry_t *entry )
+{
+	gclient_t *cl = player->client;
+
+	entry->valid = true;
+	entry->enterTime = cl->pers.enterTime;
+	entry->team = cl->pers.team;
+	entry->location = cl->pers.location;
+	entry->credit = cl->pers.credit;
+	entry->health = 0;
+	entry->weaponClass = WP_NONE;
+	entry->upgrade = UP_NONE;
+
+	if ( cl->sess.spectatorState != SPECTATOR_NOT )
+	{
+		return;
+	}
+
+	if ( cl->pers.team == TEAM_HUMANS )
+	{
+		entry->weaponClass = cl->ps.weapon;
+
+		if ( BG_InventoryContainsUpgrade( UP_BATTLESUIT, cl->ps.stats ) )
+		{
+			entry->upgrade = UP_BATTLESUIT;
+		}
+		else if ( BG_InventoryContainsUpgrade( UP_JETPACK, cl->ps.stats ) )
+		{
+			entry->upgrade = UP_JETPACK;
+		}
+		else if ( BG_InventoryContainsUpgrade( UP_RADAR, cl->ps.stats ) )
+		{
+			entry->upgrade = UP_RADAR;
+		}
+		else if ( BG_InventoryContainsUpgrade( UP_LIGHTARMOUR, cl->ps.stats ) )
+		{
+			entry->upgrade = UP_LIGHTARMOUR;
+		}
+
+		entry->health = static_cast<int>( std::ceil( Entities::HealthOf(player) ) );
+	}
+	else if ( cl->pers.team == TEAM_ALIENS )
+	{
+		entry->weaponClass = cl->ps.stats[ STAT_CLASS ];
+		entry->health = static_cast<int>( std::ceil( Entities::HealthOf(player) ) );
+	}
+}
+
+/*
+==================
+G_ResetTeamInfo
+
+Forget what a client was sent, so that its next message is a full update
+==================
+*/
+void G_ResetTeamInfo( int clientNum )
+{
+	for ( teamInfoEntry_t &e : teamInfoSent[ clientNum ].entries )
+	{
+		e.valid = false;
+	}
+}
+
 /*
 ==================
 TeamplayInfoMessage
 
 Format:
-  clientNum location health weapon upgrade
+  clientNum mask [location] [health] [weapon] [credit] [upgrade]
 
+Only the fields that changed since the last message to this client are
+sent, see teamInfoField_t.
 ==================
 */
 void TeamplayInfoMessage( gentity_t *ent )
 {
-	char      entry[ 24 ];
+	char      entry[ 40 ];
 	char      string[ ( MAX_CLIENTS - 1 ) * ( sizeof( entry ) - 1 ) + 1 ];
 	int       i, j;
-	int       team, stringlength;
+	team_t    team;
+	int       stringlength;
 	gentity_t *player;
 	gclient_t *cl;
-	upgrade_t upgrade = UP_NONE;
-	int       curWeaponClass = WP_NONE; // sends weapon for humans, class for aliens
-	int       health = 0;
 
 	if ( !g_allowTeamOverlay.Get() )
 	{
@@ -416,6 +507,15 @@ void TeamplayInfoMessage( gentity_t *ent )
 		team = ent->client->pers.team;
 	}
 
+	auto &sent = teamInfoSent[ ent->num() ];
+
+	// the overlay was (re)enabled, or the client changed teams or reconnected
+	if ( sent.sentTime != ent->client->pers.teamInfo || sent.team != team )
+	{
+		G_ResetTeamInfo( ent->num() );
+		sent.team = team;
+	}
+
 	string[ 0 ] = '\0';
 	stringlength = 0;
 
@@ -430,68 +530,58 @@ void TeamplayInfoMessage( gentity_t *ent )
 			continue;
 		}
 
-		// only update if changed since last time
-		if ( cl->pers.infoChangeTime <= ent->client->pers.teamInfo )
+		teamInfoEntry_t current;
+		teamInfoEntry_t &last = sent.entries[ i ];
+		int mask = TEAMINFO_ALL;
+
+		G_TeamInfoEntry( player, &current );
+
+		if ( last.valid && last.enterTime == current.enterTime && last.team == current.team )
 		{
-			continue;
+			mask = 0;
+			if ( last.location != current.location )       mask |= TEAMINFO_LOCATION;
+			if ( last.health != current.health )           mask |= TEAMINFO_HEALTH;
+			if ( last.weaponClass != current.weaponClass ) mask |= TEAMINFO_WEAPONCLASS;
+			if ( last.credit != current.credit )           mask |= TEAMINFO_CREDIT;
+			if ( last.upgrade != current.upgrade )         mask |= TEAMINFO_UPGRADE;
 		}
 
-		if ( cl->sess.spectatorState != SPECTATOR_NOT )
+		if( team == TEAM_ALIENS ) // aliens don't have upgrades
 		{
-			curWeaponClass = WP_NONE;
-			upgrade = UP_NONE;
+			mask &= ~TEAMINFO_UPGRADE;
 		}
-		else if ( cl->pers.team == TEAM_HUMANS )
+
+		if ( !mask )
 		{
-			curWeaponClass = cl->ps.weapon;
+			continue;
+		}
 
-			if ( BG_InventoryContainsUpgrade( UP_BATTLESUIT, cl->ps.stats ) )
-			{
-				upgrade = UP_BATTLESUIT;
-			}
-			else if ( BG_InventoryContainsUpgrade( UP_JETPACK, cl->ps.stats ) )
-			{
-				upgrade = UP_JETPACK;
-			}
-			else if ( BG_InventoryContainsUpgrade( UP_RADAR, cl->ps.stats ) )
-			{
-				upgrade = UP_RADAR;
-			}
-			else if ( BG_InventoryContainsUpgrade( UP_LIGHTARMOUR, cl->ps.stats ) )
-			{
-				upgrade = UP_LIGHTARMOUR;
-			}
-			else
-			{
-				upgrade = UP_NONE;
-			}
-			health = static_cast<int>( std::ceil( Entities::HealthOf(player) ) );
+		Com_sprintf( entry, sizeof( entry ), " %i %x", i, mask );
+
+		if ( mask & TEAMINFO_LOCATION )
+		{
+			Q_strcat( entry, sizeof( entry ), va( " %i", current.location ) );
 		}
-		else if ( cl->pers.team == TEAM_ALIENS )
+
+		if ( mask & TEAMINFO_HEALTH )
 		{
-			curWeaponClass = cl->ps.stats[ STAT_CLASS ];
-			upgrade = UP_NONE;
-			health = static_cast<int>( std::ceil( Entities::HealthOf(player) ) );
+			Q_strcat( entry, sizeof( entry ), va( " %i", current.health ) );
 		}
 
-		if( team == TEAM_ALIENS ) // aliens don't have upgrades
+		if ( mask & TEAMINFO_WEAPONCLASS )
 		{
-			Com_sprintf( entry, sizeof( entry ), " %i %i %i %i %i", i,
-						 cl->pers.location,
-			             health,
-						 curWeaponClass,
-						 cl->pers.credit );
+			Q_strcat( entry, sizeof( entry ), va( " %i", current.weaponClass ) );
 		}
-		else
+
+		if ( mask & TEAMINFO_CREDIT )
 		{
-			Com_sprintf( entry, sizeof( entry ), " %i %i %i %i %i %i", i,
-			             cl->pers.location,
-			             health,
-			             curWeaponClass,
-			             cl->pers.credit,
-			             upgrade );
+			Q_strcat( entry, sizeof( entry ), va( " %i", current.credit ) );
 		}
 
+		if ( mask & TEAMINFO_UPGRADE )
+		{
+			Q_strcat( entry, sizeof( entry ), va( " %i", current.upgrade ) );
+		}
 
 		j = strlen( entry );
 
@@ -503,6 +593,7 @@ void TeamplayInfoMessage( gentity_t *ent )
 
 		strcpy( string + stringlength, entry );
 		stringlength += j;
+		last = current;
 	}
 
 	if( string[ 0 ] )
@@ -510,6 +601,8 @@ void TeamplayInfoMessage( gentity_t *ent )
 		trap_SendServerCommand( ent->num(), va( "tinfo%s", string ) );
 		ent->client->pers.teamInfo = level.time;
 	}
+
+	sent.sentTime = ent->client->pers.teamInfo;
 }
 
 static Cvar::Cvar<bool> countBots("g_teamBalanceCountBots", "include bots when checking team size", Cvar::NONE, false);
@@ -542,15 +635,10 @@ void CheckTeamStatus()
 
 				if ( loc )
 				{
-					if( ent->client->pers.location != loc->s.generic1 )
-					{
-						ent->client->pers.infoChangeTime = level.time;
-						ent->client->pers.location = loc->s.generic1;
-					}
+					ent->client->pers.location = loc->s.generic1;
 				}
-				else if ( ent->client->pers.location != 0 )
+				else
 				{
-					ent->client->pers.infoChangeTime = level.time;
 					ent->client->pers.location = 0;
 				}
 			}
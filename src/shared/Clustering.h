@@ -168,6 +168,10 @@ namespace Clustering {
 	 * In the minimum spanning tree of all edges that pass the optional visibility check, delete the
 	 * edges that are longer than the average plus the standard deviation multiplied by a "laxity"
 	 * factor. The remaining trees span the clusters.
+	 *
+	 * The minimum spanning tree is maintained incrementally: An added object can only connect to
+	 * the old tree through its own edges, and removing an object only requires reconnecting the
+	 * trees it leaves behind.
 	 */
 	template <typename Data, int Dim>
 	class EuclideanClustering {
@@ -188,13 +192,12 @@ namespace Clustering {
 			                    std::function<bool(Data, Data)> edgeVisCallback_ = nullptr) :
 				clusters(),
 				records(),
-				edges(),
+				neighbors(),
 				mstEdges(),
 				forestEdges(),
 				mstAverageDistance(0.0f),
 				mstStandardDeviation(0.0f),
 				dirtyClusters(true),
-				dirtyMST(true),
 				laxity(laxity_),
 				edgeVisCallback(edgeVisCallback_)
 			{}
@@ -203,24 +206,36 @@ namespace Clustering {
 			 * @brief Adds or updates the location of objects.
 			 */
 			void Update(const Data& data, const point_type& location) {
-				// TODO: Check if the location has actually changed.
+				auto known = records.find(data);
+
+				if (known != records.end()) {
+					if (known->second == location) return;
+
+					Remove(data);
+				}
 
-				// Remove the object first.
-				Remove(data);
+				// Connect the object to all other objects and remember the new edges.
+				std::unordered_map<Data, float>& adjacent = neighbors[data];
+				std::vector<weighted_edge_type> newEdges;
 
-				// Iterate over all other objects and save the distance.
 				for (const vertex_record_type& record : records) {
 					if (edgeVisCallback == nullptr || edgeVisCallback(data, record.first)) {
 						float distance = glm::distance(location, record.second);
-						edges.emplace(distance, edge_type(data, record.first));
+						adjacent.emplace(record.first, distance);
+						neighbors[record.first].emplace(data, distance);
+						newEdges.emplace_back(distance, edge_type(data, record.first));
 					}
 				}
 
 				// The object is now known.
 				records.insert(std::make_pair(data, location));
 
-				// Rebuild MST and clusters on next read access.
-				dirtyMST = true;
+				// The new minimum spanning tree only uses edges of the old one and the new edges.
+				for (const edge_record_type& edgeRecord : mstEdges) {
+					newEdges.emplace_back(edgeRecord.first, edgeRecord.second);
+				}
+
+				FindMST(newEdges);
 			}
 
 			/**
@@ -228,30 +243,44 @@ namespace Clustering {
 			 * @return Whether the object was known.
 			 */
 			bool Remove(const Data& data) {
-				// Check if we even know the object in O(n) to avoid unnecessary O(m) iteration.
 				if (records.find(data) == records.end()) return false;
 
 				// Delete all edges that involve the object.
-				for (auto edge = edges.begin(); edge != edges.end(); ) {
-				    if ((*edge).second.first == data || (*edge).second.second == data) {
-						edge = edges.erase(edge);
+				for (const auto& neighbor : neighbors[data]) {
+					neighbors[neighbor.first].erase(data);
+				}
+				neighbors.erase(data);
+
+				// Forget about the object.
+				records.erase(data);
+
+				// Drop its edges from the minimum spanning tree.
+				int numDroppedEdges = 0;
+				for (auto edge = mstEdges.begin(); edge != mstEdges.end(); ) {
+					if (edge->second.first == data || edge->second.second == data) {
+						edge = mstEdges.erase(edge);
+						numDroppedEdges++;
 					} else {
 						edge++;
 					}
 				}
 
-				// Forget about the object.
-				records.erase(data);
+				// A leaf leaves a minimum spanning tree of the remaining objects behind.
+				if (numDroppedEdges > 1) {
+					ReconnectMST();
+				}
 
-				// Rebuild MST and clusters on next read access.
-				dirtyMST = true;
+				// Rebuild clusters on next read access.
+				dirtyClusters = true;
 
 				return true;
 			}
 
 			void Clear() {
 				records.clear();
-				dirtyMST = true;
+				neighbors.clear();
+				mstEdges.clear();
+				dirtyClusters = true;
 			}
 
 			/**
@@ -264,33 +293,38 @@ namespace Clustering {
 			}
 
 			iter_type begin() {
-				if (dirtyMST || dirtyClusters) GenerateClusters();
+				if (dirtyClusters) GenerateClusters();
 				return clusters.begin();
 			}
 
 			iter_type end() {
-				if (dirtyMST || dirtyClusters) GenerateClusters();
+				if (dirtyClusters) GenerateClusters();
 				return clusters.end();
 			}
 
 		private:
+			using weighted_edge_type = std::pair<float, edge_type>;
+
 			/**
-			 * @brief Finds the minimum spanning tree in the graph defined by edges, where edge
-			 *        weight is the euclidean distance of the data object's location.
+			 * @brief Finds the minimum spanning tree in the graph defined by the given edges, where
+			 *        edge weight is the euclidean distance of the data object's location.
 			 *
 			 * Uses Kruskal's algorithm.
 			 */
-			void FindMST() {
+			void FindMST(std::vector<weighted_edge_type>& candidateEdges) {
 				// Clear an existing MST.
 				mstEdges.clear();
-				mstAverageDistance   = 0;
-				mstStandardDeviation = 0;
+
+				std::sort(candidateEdges.begin(), candidateEdges.end(),
+				          [](const weighted_edge_type& a, const weighted_edge_type& b) {
+					return a.first < b.first;
+				});
 
 				// Track connected components for circle prevention.
 				DisjointSets<Data> components = DisjointSets<Data>();
 
-				// The edges are implicitely sorted by distance, iterate in ascending order.
-				for (const edge_record_type& edgeRecord : edges) {
+				// Iterate in ascending order of distance.
+				for (const weighted_edge_type& edgeRecord : candidateEdges) {
 					float distance        = edgeRecord.first;
 					const edge_type& edge = edgeRecord.second;
 
@@ -315,28 +349,102 @@ namespace Clustering {
 					// Mark components as connected.
 					components.Link(firstVertexRepr, secondVertexRepr);
 
-					// Add the edge to the MST.
-					mstEdges.emplace(distance, edge);
+					// Add the edge to the MST, candidates are sorted so append.
+					mstEdges.emplace_hint(mstEdges.end(), distance, edge);
+				}
+
+				dirtyClusters = true;
+			}
+
+			/**
+			 * @brief Reconnects the trees that are left when an inner vertex is removed from the
+			 *        minimum spanning tree.
+			 *
+			 * Edges within one of the trees can't be part of the new minimum spanning tree, so only
+			 * the edges between them are considered. Each such edge has an endpoint outside of the
+			 * largest tree, which therefore doesn't need to be searched.
+			 */
+			void ReconnectMST() {
+				std::unordered_map<Data, std::vector<Data>> treeNeighbors;
+				for (const edge_record_type& edgeRecord : mstEdges) {
+					treeNeighbors[edgeRecord.second.first].push_back(edgeRecord.second.second);
+					treeNeighbors[edgeRecord.second.second].push_back(edgeRecord.second.first);
+				}
+
+				// Label the trees.
+				std::unordered_map<Data, int> treeOf;
+				std::vector<Data> stack;
+				int numTrees = 0, largestTree = 0, largestTreeSize = 0;
 
-					// Add distance to average.
-					mstAverageDistance += distance;
+				for (const vertex_record_type& record : records) {
+					if (treeOf.find(record.first) != treeOf.end()) continue;
+
+					int tree = numTrees++, treeSize = 0;
+					treeOf.emplace(record.first, tree);
+					stack.push_back(record.first);
+
+					while (!stack.empty()) {
+						Data vertex = stack.back();
+						stack.pop_back();
+						treeSize++;
+
+						for (const Data& neighbor : treeNeighbors[vertex]) {
+							if (treeOf.emplace(neighbor, tree).second) {
+								stack.push_back(neighbor);
+							}
+						}
+					}
+
+					if (treeSize > largestTreeSize) {
+						largestTree     = tree;
+						largestTreeSize = treeSize;
+					}
 				}
 
-				// Save metadata.
-				int numMstEdges = mstEdges.size();
-				if (numMstEdges != 0) {
-					// Average distances.
-					mstAverageDistance /= numMstEdges;
-
-					// Find standard deviation.
-					for (const edge_record_type& edgeRecord : mstEdges) {
-						float deviation = mstAverageDistance - edgeRecord.first;
-						mstStandardDeviation += deviation * deviation;
+				// Collect the edges between trees, each once.
+				std::vector<weighted_edge_type> candidateEdges;
+
+				for (const vertex_record_type& record : records) {
+					int tree = treeOf[record.first];
+					if (tree == largestTree) continue;
+
+					for (const auto& neighbor : neighbors[record.first]) {
+						int neighborTree = treeOf[neighbor.first];
+						if (neighborTree == tree) continue;
+						if (neighborTree != largestTree && std::less<Data>()(neighbor.first, record.first)) continue;
+
+						candidateEdges.emplace_back(neighbor.second, edge_type(record.first, neighbor.first));
 					}
-					mstStandardDeviation = sqrtf(mstStandardDeviation / numMstEdges);
 				}
 
-				dirtyMST = false;
+				for (const edge_record_type& edgeRecord : mstEdges) {
+					candidateEdges.emplace_back(edgeRecord.first, edgeRecord.second);
+				}
+
+				FindMST(candidateEdges);
+			}
+
+			/**
+			 * @brief Calculates the average and standard deviation of the edge length in the minimum
+			 *        spanning tree.
+			 */
+			void UpdateMSTMetadata() {
+				mstAverageDistance   = 0;
+				mstStandardDeviation = 0;
+
+				int numMstEdges = mstEdges.size();
+				if (numMstEdges == 0) return;
+
+				for (const edge_record_type& edgeRecord : mstEdges) {
+					mstAverageDistance += edgeRecord.first;
+				}
+				mstAverageDistance /= numMstEdges;
+
+				for (const edge_record_type& edgeRecord : mstEdges) {
+					float deviation = mstAverageDistance - edgeRecord.first;
+					mstStandardDeviation += deviation * deviation;
+				}
+				mstStandardDeviation = sqrtf(mstStandardDeviation / numMstEdges);
 			}
 
 			/**
@@ -347,9 +455,7 @@ namespace Clustering {
 			 * clusters.
 			 */
 			void GenerateClusters() {
-				if (dirtyMST) {
-					FindMST();
-				}
+				UpdateMSTMetadata();
 
 				// Clear an existing clustering.
 				forestEdges.clear();
@@ -420,11 +526,12 @@ namespace Clustering {
 			/** Maps data objects to their location. */
 			std::unordered_map<Data, point_type> records;
 
-			/**  The edges of a non-reflexive graph of the data objects, sorted by distance. */
-			std::multimap<float, edge_type> edges;
+			/** The edges of a non-reflexive graph of the data objects, as a map from each object to
+			 *  its neighbors and their distance. */
+			std::unordered_map<Data, std::unordered_map<Data, float>> neighbors;
 
-			/** The edges of the minimum spanning tree in the graph defined by edges, sorted by
-			 *  distance. Is a subset of edges. */
+			/** The edges of the minimum spanning tree in the graph defined by neighbors, sorted by
+			 *  distance. */
 			std::multimap<float, edge_type> mstEdges;
 
 			/** The edges of a forest of which each connected component spans a cluster. Is a subset
@@ -437,19 +544,14 @@ namespace Clustering {
 			/** The standard deviation of the edge length in the minimum spanning tree. */
 			float mstStandardDeviation;
 
-			/** Whether clusters need to be rebuilt on read access. Does not imply regeneration of
-			 *  the minimum spanning tree. */
+			/** Whether clusters need to be rebuilt on read access. */
 			bool dirtyClusters;
 
-			/** Whether the minimum spanning tree needs to be rebuild on read access. Implies
-			 *  regeneration of clusters. */
-			bool dirtyMST;
-
 			/** A factor that scales the allowed deviation from the average edge length when
 			 *  splitting the minimum spanning tree into cluster spanning trees. */
 			float laxity;
 
-			/** A callback relation that decides whether an edge should be part of edges.
+			/** A callback relation that decides whether an edge should be part of neighbors.
 			 *  Needs to be symmetric as edges are bidirectional. */
 			std::function<bool(Data, Data)> edgeVisCallback;
 	};
@@ -1075,6 +1075,19 @@ enum spectatorState_t
   SPECTATOR_SCOREBOARD
 };
 
+// fields of a team overlay ("tinfo") entry
+// every entry is "clientNum mask" followed by the fields in mask, in this order
+enum teamInfoField_t
+{
+  TEAMINFO_LOCATION    = BIT( 0 ),
+  TEAMINFO_HEALTH      = BIT( 1 ),
+  TEAMINFO_WEAPONCLASS = BIT( 2 ), // weapon for humans, class for aliens
+  TEAMINFO_CREDIT      = BIT( 3 ),
+  TEAMINFO_UPGRADE     = BIT( 4 ), // humans only
+
+  TEAMINFO_ALL         = BIT( 5 ) - 1
+};
+
 // modes of text communication
 enum saymode_t
 {
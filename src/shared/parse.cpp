@@ -201,6 +201,8 @@ struct indent_t
 	indent_t *next; //next indent on the indent stack
 };
 
+struct tokenCache_t;
+
 //source file
 struct source_t
 {
@@ -215,6 +217,7 @@ struct source_t
 	indent_t      *indentstack; //stack with indents
 	int           skip; // > 0 if skipping conditional code
 	token_t       token; //last read token
+	tokenCache_t  *cache; //token stream recorded or replayed, see Parse_LoadSourceHandle
 };
 
 #define MAX_DEFINEPARMS 128
@@ -230,6 +233,9 @@ struct directive_t
 
 int             numtokens;
 
+//number of errors and warnings printed, a source is only cached if it had none
+static int      numParseMessages;
+
 //list with global defines added to every source loaded
 define_t        *globaldefines;
 
@@ -313,6 +319,7 @@ punctuation_t   Default_Punctuations[] =
 
 static bool Parse_ReadToken( source_t *source, token_t *token );
 static bool Parse_AddDefineToSourceFromString( source_t *source, const char *string );
+static void Parse_RecordScript( const source_t *source, const script_t *script );
 
 /*
 ===============
@@ -375,6 +382,8 @@ static void PRINTF_LIKE(2) Parse_ScriptError( const script_t *script, const char
 	char    text[ 1024 ];
 	va_list ap;
 
+	numParseMessages++;
+
 	if ( script->flags & SCFL_NOERRORS ) { return; }
 
 	va_start( ap, str );
@@ -393,6 +402,8 @@ static void PRINTF_LIKE(2) Parse_ScriptWarning( const script_t *script, const ch
 	char    text[ 1024 ];
 	va_list ap;
 
+	numParseMessages++;
+
 	if ( script->flags & SCFL_NOWARNINGS ) { return; }
 
 	va_start( ap, str );
@@ -1254,6 +1265,8 @@ static void PRINTF_LIKE(2) Parse_SourceError( const source_t *source, const char
 	char    text[ 1024 ];
 	va_list ap;
 
+	numParseMessages++;
+
 	va_start( ap, str );
 	vsprintf( text, str, ap );
 	va_end( ap );
@@ -1270,6 +1283,8 @@ static void PRINTF_LIKE(2) Parse_SourceWarning( const source_t *source, const ch
 	char    text[ 1024 ];
 	va_list ap;
 
+	numParseMessages++;
+
 	va_start( ap, str );
 	vsprintf( text, str, ap );
 	va_end( ap );
@@ -2941,6 +2956,7 @@ static int Parse_Directive_include( source_t *source )
 		return false;
 	}
 
+	Parse_RecordScript( source, script );
 	Parse_PushScript( source, script );
 	return true;
 }
@@ -4171,6 +4187,398 @@ static void Parse_FreeSource( source_t *source )
 	BG_Free( source );
 }
 
+/*
+===============================================================================
+
+Token cache
+
+The preprocessed token stream of a source is written to the home path the
+first time it is read to its end without any error or warning. Later loads
+replay it instead of tokenizing and preprocessing the scripts again, as long
+as the source, every script it included, the global defines and the game
+version are unchanged.
+
+Values are in native byte order, the cache is only read back by the build
+that wrote it in the same home path, one of the other byte order fails the
+version check and is rewritten.
+
+file    := "UPTC" version:u32 key:u64 numScripts:u32 script[numScripts]
+           numTokens:u32 token[numTokens] endLine:i32
+script  := name:str hash:u64
+token   := type:u8 subtype:i32 intvalue:i32 floatvalue:f32 line:i32 string:str
+str     := length:u16 bytes
+
+===============================================================================
+*/
+
+// the VMs have different global defines, so they don't share their caches
+#ifdef BUILD_CGAME
+static const char     TOKEN_CACHE_DIR[] = "parsecache/cgame/";
+#else
+static const char     TOKEN_CACHE_DIR[] = "parsecache/sgame/";
+#endif
+
+static const char     TOKEN_CACHE_MAGIC[ 4 ] = { 'U', 'P', 'T', 'C' };
+// Increment this if the preprocessor or the format changes
+static const uint32_t TOKEN_CACHE_VERSION = 1;
+
+static const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+static const uint64_t FNV_PRIME = 1099511628211ULL;
+
+namespace {
+
+//token as returned by Parse_ReadTokenHandle
+struct cachedToken_t
+{
+	tokenType_t type;
+	int         subtype;
+	int         intvalue;
+	float       floatvalue;
+	int         line; //line of the script after the token was read
+	std::string string;
+};
+
+//script included by a source
+struct cachedScript_t
+{
+	std::string name;
+	uint64_t    hash;
+};
+
+struct tokenCache_t
+{
+	std::string                 filename; //of the cache file
+	uint64_t                    key; //hash of the version, the source and the global defines
+	std::vector<cachedScript_t> scripts;
+	std::vector<cachedToken_t>  tokens;
+	int                         endLine = 0;
+	bool                        recording = false;
+	bool                        replaying = false;
+	int                         numParseMessages = 0; //when the recording started
+	size_t                      next = 0; //next token to replay
+	int                         line = 1; //line of the last replayed token
+};
+
+} // namespace
+
+/*
+===============
+Parse_Hash
+
+64-bit FNV-1a
+===============
+*/
+static uint64_t Parse_Hash( const void *data, size_t length, uint64_t hash )
+{
+	const byte *p = static_cast<const byte *>( data );
+
+	for ( size_t i = 0; i < length; i++ )
+	{
+		hash = ( hash ^ p[ i ] ) * FNV_PRIME;
+	}
+
+	return hash;
+}
+
+static uint64_t Parse_HashString( const char *string, uint64_t hash )
+{
+	//include the terminator so that consecutive strings can't run into each other
+	return Parse_Hash( string, strlen( string ) + 1, hash );
+}
+
+/*
+===============
+Parse_HashGlobalDefines
+===============
+*/
+static uint64_t Parse_HashGlobalDefines( uint64_t hash )
+{
+	for ( const define_t *define = globaldefines; define; define = define->next )
+	{
+		hash = Parse_HashString( define->name, hash );
+		hash = Parse_Hash( &define->numparms, sizeof( define->numparms ), hash );
+
+		for ( const token_t *token = define->parms; token; token = token->next )
+		{
+			hash = Parse_HashString( token->string, hash );
+		}
+
+		for ( const token_t *token = define->tokens; token; token = token->next )
+		{
+			hash = Parse_HashString( token->string, hash );
+		}
+	}
+
+	return hash;
+}
+
+/*
+===============
+Parse_HashScriptFile
+===============
+*/
+static bool Parse_HashScriptFile( const char *filename, int (*openFunc)(Str::StringRef, fileHandle_t &), uint64_t *hash )
+{
+	script_t *script = Parse_LoadScriptFile( filename, openFunc );
+
+	if ( !script ) { return false; }
+
+	*hash = Parse_Hash( script->buffer, script->length, FNV_OFFSET_BASIS );
+	Parse_FreeScript( script );
+	return true;
+}
+
+/*
+===============
+Parse_RecordScript
+
+Remembers an included script so that the cache can be checked against it
+===============
+*/
+static void Parse_RecordScript( const source_t *source, const script_t *script )
+{
+	if ( !source->cache || !source->cache->recording ) { return; }
+
+	source->cache->scripts.push_back( { script->filename, Parse_Hash( script->buffer, script->length, FNV_OFFSET_BASIS ) } );
+}
+
+namespace {
+
+//bounds checked reads from a cache file
+class TokenCacheReader
+{
+public:
+	TokenCacheReader( const std::string &data ) : data_( data ), offset_( 0 ) { }
+
+	template<typename T>
+	bool Read( T *value )
+	{
+		if ( data_.size() - offset_ < sizeof( T ) ) { return false; }
+
+		memcpy( value, data_.data() + offset_, sizeof( T ) );
+		offset_ += sizeof( T );
+		return true;
+	}
+
+	bool ReadString( std::string *string )
+	{
+		uint16_t length;
+
+		if ( !Read( &length ) || data_.size() - offset_ < length ) { return false; }
+
+		string->assign( data_, offset_, length );
+		offset_ += length;
+		return true;
+	}
+
+	bool AtEnd() const
+	{
+		return offset_ == data_.size();
+	}
+
+private:
+	const std::string &data_;
+	size_t            offset_;
+};
+
+} // namespace
+
+/*
+===============
+Parse_ReadTokenCache
+
+Replaces the tokens of the cache with those of its file, if it matches the
+cache key and none of the included scripts changed
+===============
+*/
+static bool Parse_ReadTokenCache( tokenCache_t *cache, int (*openFunc)(Str::StringRef, fileHandle_t &) )
+{
+	fileHandle_t f;
+	int length = trap_FS_FOpenFile( cache->filename.c_str(), &f, fsMode_t::FS_READ );
+
+	if ( length < 0 || !f ) { return false; }
+
+	std::string data( length, '\0' );
+	trap_FS_Read( &data[ 0 ], length, f );
+	trap_FS_FCloseFile( f );
+
+	TokenCacheReader reader( data );
+	char             magic[ sizeof( TOKEN_CACHE_MAGIC ) ];
+	uint32_t         version, count;
+	uint64_t         key;
+
+	if ( !reader.Read( &magic ) || memcmp( magic, TOKEN_CACHE_MAGIC, sizeof( magic ) ) ||
+	     !reader.Read( &version ) || version != TOKEN_CACHE_VERSION ||
+	     !reader.Read( &key ) || key != cache->key ||
+	     !reader.Read( &count ) )
+	{
+		return false;
+	}
+
+	for ( uint32_t i = 0; i < count; i++ )
+	{
+		std::string name;
+		uint64_t    hash, currentHash;
+
+		if ( !reader.ReadString( &name ) || !reader.Read( &hash ) )
+		{
+			return false;
+		}
+
+		if ( !Parse_HashScriptFile( name.c_str(), openFunc, &currentHash ) || currentHash != hash )
+		{
+			return false;
+		}
+	}
+
+	if ( !reader.Read( &count ) )
+	{
+		return false;
+	}
+
+	std::vector<cachedToken_t> tokens( count );
+
+	for ( cachedToken_t &token : tokens )
+	{
+		uint8_t type;
+
+		if ( !reader.Read( &type ) || type > Util::ordinal( tokenType_t::TT_PUNCTUATION ) ||
+		     !reader.Read( &token.subtype ) || !reader.Read( &token.intvalue ) ||
+		     !reader.Read( &token.floatvalue ) || !reader.Read( &token.line ) ||
+		     !reader.ReadString( &token.string ) )
+		{
+			return false;
+		}
+
+		token.type = Util::enum_cast<tokenType_t>( type );
+	}
+
+	if ( !reader.Read( &cache->endLine ) || !reader.AtEnd() )
+	{
+		return false;
+	}
+
+	cache->tokens = std::move( tokens );
+	return true;
+}
+
+/*
+===============
+Parse_WriteTokenCache
+===============
+*/
+static void Parse_WriteTokenCache( const tokenCache_t *cache )
+{
+	std::string data;
+
+	auto Write = [ &data ]( const void *value, size_t size ) {
+		data.append( static_cast<const char *>( value ), size );
+	};
+
+	auto WriteString = [ &Write ]( const std::string &string ) {
+		uint16_t length = static_cast<uint16_t>( std::min<size_t>( string.size(), UINT16_MAX ) );
+		Write( &length, sizeof( length ) );
+		Write( string.data(), length );
+	};
+
+	uint32_t numScripts = cache->scripts.size();
+	uint32_t numTokens = cache->tokens.size();
+
+	Write( TOKEN_CACHE_MAGIC, sizeof( TOKEN_CACHE_MAGIC ) );
+	Write( &TOKEN_CACHE_VERSION, sizeof( TOKEN_CACHE_VERSION ) );
+	Write( &cache->key, sizeof( cache->key ) );
+
+	Write( &numScripts, sizeof( numScripts ) );
+	for ( const cachedScript_t &script : cache->scripts )
+	{
+		WriteString( script.name );
+		Write( &script.hash, sizeof( script.hash ) );
+	}
+
+	Write( &numTokens, sizeof( numTokens ) );
+	for ( const cachedToken_t &token : cache->tokens )
+	{
+		uint8_t type = Util::ordinal( token.type );
+
+		Write( &type, sizeof( type ) );
+		Write( &token.subtype, sizeof( token.subtype ) );
+		Write( &token.intvalue, sizeof( token.intvalue ) );
+		Write( &token.floatvalue, sizeof( token.floatvalue ) );
+		Write( &token.line, sizeof( token.line ) );
+		WriteString( token.string );
+	}
+
+	Write( &cache->endLine, sizeof( cache->endLine ) );
+
+	fileHandle_t f;
+	trap_FS_FOpenFile( cache->filename.c_str(), &f, fsMode_t::FS_WRITE );
+
+	if ( !f )
+	{
+		Log::Verbose( "Can't write token cache %s", cache->filename );
+		return;
+	}
+
+	trap_FS_Write( data.data(), data.size(), f );
+	trap_FS_FCloseFile( f );
+}
+
+/*
+===============
+Parse_OpenTokenCache
+
+Sets up replaying the cached tokens of a freshly loaded source, or recording
+them if there is no valid cache
+===============
+*/
+static tokenCache_t *Parse_OpenTokenCache( const source_t *source )
+{
+	const script_t *script = source->scriptstack;
+	auto           *cache = new tokenCache_t;
+
+	cache->filename = std::string( TOKEN_CACHE_DIR ) + source->filename + ".tokens";
+	cache->key = Parse_HashString( PRODUCT_VERSION, FNV_OFFSET_BASIS );
+	cache->key = Parse_Hash( script->buffer, script->length, cache->key );
+	cache->key = Parse_HashGlobalDefines( cache->key );
+
+	if ( Parse_ReadTokenCache( cache, source->openFunc ) )
+	{
+		cache->replaying = true;
+	}
+	else
+	{
+		cache->recording = true;
+		cache->numParseMessages = numParseMessages;
+	}
+
+	return cache;
+}
+
+/*
+===============
+Parse_FinishTokenCache
+
+Writes the recorded tokens once the whole source was read without problems
+===============
+*/
+static void Parse_FinishTokenCache( source_t *source )
+{
+	tokenCache_t   *cache = source->cache;
+	const script_t *script = source->scriptstack;
+
+	if ( !cache->recording ) { return; }
+
+	cache->recording = false;
+
+	bool complete = script && !script->next && Parse_EndOfScript( script ) &&
+	                !source->tokens && !source->indentstack;
+
+	if ( !complete || numParseMessages != cache->numParseMessages ) { return; }
+
+	cache->endLine = script->line;
+	Parse_WriteTokenCache( cache );
+}
+
 static const int MAX_SOURCEFILES = 64;
 
 source_t *sourceFiles[ MAX_SOURCEFILES ];
@@ -4205,6 +4613,7 @@ int Parse_LoadSourceHandle( const char *filename, int (*openFunc)(Str::StringRef
 		return 0;
 	}
 
+	source->cache = Parse_OpenTokenCache( source );
 	sourceFiles[ i ] = source;
 	return i;
 }
@@ -4226,6 +4635,7 @@ int Parse_FreeSourceHandle( int handle )
 		return false;
 	}
 
+	delete sourceFiles[ handle ]->cache;
 	Parse_FreeSource( sourceFiles[ handle ] );
 	sourceFiles[ handle ] = nullptr;
 	return true;
@@ -4239,6 +4649,8 @@ Parse_ReadTokenHandle
 bool Parse_ReadTokenHandle( int handle, pc_token_t *pc_token )
 {
 	token_t token;
+	source_t *source;
+	tokenCache_t *cache;
 
 	if ( handle < 1 || handle >= MAX_SOURCEFILES )
 	{
@@ -4250,8 +4662,31 @@ bool Parse_ReadTokenHandle( int handle, pc_token_t *pc_token )
 		return false;
 	}
 
-	if ( !Parse_ReadToken( sourceFiles[ handle ], &token ) )
+	source = sourceFiles[ handle ];
+	cache = source->cache;
+
+	if ( cache->replaying )
 	{
+		if ( cache->next >= cache->tokens.size() )
+		{
+			cache->line = cache->endLine;
+			return false;
+		}
+
+		const cachedToken_t &cached = cache->tokens[ cache->next++ ];
+
+		Q_strncpyz( pc_token->string, cached.string.c_str(), sizeof pc_token->string );
+		pc_token->type = cached.type;
+		pc_token->subtype = cached.subtype;
+		pc_token->intvalue = cached.intvalue;
+		pc_token->floatvalue = cached.floatvalue;
+		cache->line = cached.line;
+		return true;
+	}
+
+	if ( !Parse_ReadToken( source, &token ) )
+	{
+		Parse_FinishTokenCache( source );
 		return false;
 	}
 
@@ -4266,6 +4701,12 @@ bool Parse_ReadTokenHandle( int handle, pc_token_t *pc_token )
 		Parse_StripDoubleQuotes( pc_token->string );
 	}
 
+	if ( cache->recording )
+	{
+		cache->tokens.push_back( { pc_token->type, pc_token->subtype, pc_token->intvalue, pc_token->floatvalue,
+		                           source->scriptstack->line, pc_token->string } );
+	}
+
 	return true;
 }
 
@@ -4288,7 +4729,11 @@ int Parse_SourceFileAndLine( int handle, char (&filename)[ MAX_QPATH ], int *lin
 
 	memcpy( filename, sourceFiles[ handle ]->filename, MAX_QPATH );
 
-	if ( sourceFiles[ handle ]->scriptstack )
+	if ( sourceFiles[ handle ]->cache->replaying )
+	{
+		*line = sourceFiles[ handle ]->cache->line;
+	}
+	else if ( sourceFiles[ handle ]->scriptstack )
 	{
 		*line = sourceFiles[ handle ]->scriptstack->line;
 	}